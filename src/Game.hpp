@@ -5,11 +5,13 @@
  */
 #pragma once
 
-#include "common.hpp"
+#include "core/core.hpp"
 #include "State.hpp"
 
 class Game
 {
 public:
-    static void update(State& state);
+    // one live tick; `state.prevGameState` must be the state before it
+    // (what changed triggers the sounds)
+    static void update(State& state, bool flap);
 };
\ No newline at end of file
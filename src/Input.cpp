@@ -5,8 +5,10 @@
  */
 #include "Input.hpp"
 
-void Input::update(State &state)
+void Input::update(UiState &state)
 {
+    PROFILE_SCOPE("input");
+
     auto& inputState = state.inputState;
 
     inputState.mousePressed = (
@@ -26,4 +28,7 @@ void Input::update(State &state)
         inputState.mouseDragPos = inputState.mousePos;
     
     state.inputState.toggleGui = IsKeyPressed(KEY_G);
+    state.inputState.toggleReplay = IsKeyPressed(KEY_R);
+    state.inputState.saveReplay = IsKeyPressed(KEY_S);
+    state.inputState.exportTrace = IsKeyPressed(KEY_P);
 };
\ No newline at end of file
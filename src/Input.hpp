@@ -7,9 +7,10 @@
 
 #include "common.hpp"
 #include "State.hpp"
+#include "core/Profiler.hpp"
 
 class Input
 {
 public:
-    static void update(State& state);
+    static void update(UiState& state);
 };
\ No newline at end of file
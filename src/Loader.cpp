@@ -0,0 +1,200 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Loader.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "Loader.hpp"
+#include "core/Profiler.hpp"
+
+
+Loader::~Loader()
+{
+#if defined(LOADER_THREAD)
+    if (this->mWorker.joinable())
+        this->mWorker.join();
+#endif
+
+    // layers that never made it to the GPU
+    for (int i = 0; i < this->mNumLayers; i++)
+        if (this->mLayers[i].image.data)
+            UnloadImage(this->mLayers[i].image);
+}
+
+
+void Loader::addLayer(SpriteId id, float y, float factor)
+{
+    assert(this->stage() == LoadStage::Idle);
+    assert(this->mNumLayers < PARALLAX_MAX_LAYERS);
+
+    Layer& layer = this->mLayers[this->mNumLayers++];
+    layer.id = id;
+    layer.y = y;
+    layer.factor = factor;
+    layer.image.data = nullptr;
+    layer.index = -1;
+}
+
+
+void Loader::start()
+{
+    assert(this->stage() == LoadStage::Idle);
+
+    this->mStage.store((int)LoadStage::Preparing, std::memory_order_release);
+#if defined(LOADER_THREAD)
+    this->mWorker = std::thread(&Loader::prepare, this);
+#endif
+}
+
+
+/**
+ * worker: everything that doesn't need the GL context
+ */
+void Loader::prepare()
+{
+#if defined(LOADER_THREAD)
+    Profiler::nameThread("loader");
+#endif
+    PROFILE_SCOPE("load assets");
+
+    auto& pack = this->mPack;
+#if EMBED_ASSETS
+    bool opened = pack.openEmbedded();
+#else
+    bool opened = pack.open(TEXTURE_PACK_PATH);
+#endif
+    if (!opened || !Resource::checkSprites(pack))
+    {
+        if (!opened)
+            printlog(2, "failed to load the asset pack (run `make pack` to build it)");
+        pack.close();
+        this->mStage.store((int)LoadStage::Failed, std::memory_order_release);
+        return;
+    }
+
+    // fault the mapping in here, so the uploads don't stall on disk reads
+    {
+        PROFILE_SCOPE("prefault");
+        unsigned sum = 0;
+        for (int i = 0; i < pack.pageCount(); i++)
+        {
+            const volatile uint8_t *pixels = pack.pixels(i);
+            uint64_t size = pack.page(i).size;
+            for (uint64_t offset = 0; offset < size; offset += PACK_PAGE_ALIGN)
+                sum += pixels[offset];
+        }
+        (void)sum;
+    }
+
+    // layer textures are cut out of the atlas on the CPU
+    for (int i = 0; i < this->mNumLayers; i++)
+    {
+        PROFILE_SCOPE("cut out layer");
+        Layer& layer = this->mLayers[i];
+        Image atlas = Resource::packImage(pack, pack.sprite((int)layer.id).page);
+        layer.image = Parallax::cutOut(atlas, Resource::spriteData(pack, layer.id, Texture2D()));
+    }
+
+    // missing sounds only stay silent (`load()` logs them)
+    if (this->mAudio)
+        this->mAudio->load(AUDIO_DIR);
+
+    this->mStage.store((int)LoadStage::Uploading, std::memory_order_release);
+}
+
+
+LoadStage Loader::update(TextureMap& texMap, Parallax& parallax, double budgetMs)
+{
+    LoadStage stage = this->stage();
+
+    if (stage == LoadStage::Preparing)
+    {
+#if defined(LOADER_THREAD)
+        return stage;
+#else
+        this->prepare();
+        return this->stage();
+#endif
+    }
+
+#if defined(LOADER_THREAD)
+    // the worker is done with everything by now
+    if (this->mWorker.joinable())
+        this->mWorker.join();
+#endif
+
+    if (stage != LoadStage::Uploading)
+        return stage;
+
+    PROFILE_SCOPE("upload assets");
+
+    double start = GetTime();
+    while (this->uploadNext(texMap, parallax) && (GetTime() - start) * 1000 < budgetMs)
+        ;
+
+    return this->stage();
+}
+
+
+/**
+ * window thread: one texture per call (rlgl can't upload parts of one)
+ */
+bool Loader::uploadNext(TextureMap& texMap, Parallax& parallax)
+{
+    auto& pack = this->mPack;
+    int numPages = pack.pageCount();
+    int next = this->mNextUpload++;
+
+    // atlas pages go straight from the mapping to the GPU
+    if (next < numPages)
+    {
+        PROFILE_SCOPE("upload page");
+        this->mPages[next] = LoadTextureFromImage(Resource::packImage(pack, next));
+        if (this->mPages[next].id == 0)
+        {
+            printlog(2, "failed to upload atlas page %i", next);
+            pack.close();
+            this->mStage.store((int)LoadStage::Failed, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    next -= numPages;
+    if (next < this->mNumLayers)
+    {
+        PROFILE_SCOPE("upload layer");
+        Layer& layer = this->mLayers[next];
+        auto& s = pack.sprite((int)layer.id);
+        layer.index = parallax.add(layer.image, Vec2f(s.sw, s.sh), layer.y, layer.factor);
+        layer.image.data = nullptr;
+        if (layer.index < 0)
+            printlog(2, "failed to create parallax layer %i", next);
+        return true;
+    }
+
+    // sprite table last, the pack isn't needed after that
+    for (int i = 0; i < SPRITE_COUNT; i++)
+        texMap[i] = Resource::spriteData(pack, (SpriteId)i, this->mPages[pack.sprite(i).page]);
+    pack.close();
+
+    this->mStage.store((int)LoadStage::Done, std::memory_order_release);
+    return false;
+}
+
+
+float Loader::progress() const
+{
+    switch (this->stage())
+    {
+        case LoadStage::Uploading:
+        {
+            // + 1 for the sprite table
+            int steps = this->mPack.pageCount() + this->mNumLayers + 1;
+            return Math::min((float)this->mNextUpload / steps, 1.0f);
+        }
+        case LoadStage::Done:
+            return 1;
+        default:
+            return 0;
+    }
+}
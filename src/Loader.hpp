@@ -0,0 +1,103 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Loader.hpp
+ * - loads the assets without blocking the window: the CPU work (mapping /
+ *   validating the pack, faulting its pages in, cutting out parallax layers,
+ *   decoding sounds) runs on a worker thread, the GPU uploads on the window
+ *   thread a few at a time (`update()`), so frames keep coming and can show
+ *   progress
+ * - the web build has no threads: the CPU work runs in the first `update()`
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "common.hpp"
+#include "Resource.hpp"
+#include "Parallax.hpp"
+#include "core/AssetPack.hpp"
+#include "core/Audio.hpp"
+
+
+#if !defined(PLATFORM_WEB)
+    #define LOADER_THREAD
+#endif
+
+// GPU upload time per frame (ms); one upload is always done
+#define LOADER_BUDGET_MS 4.0
+
+
+enum class LoadStage
+{
+    Idle,       // `start()` not called yet
+    Preparing,  // worker: pack / layer images
+    Uploading,  // window thread: textures, a few per `update()`
+    Done,
+    Failed,
+};
+
+
+class Loader
+{
+public:
+    Loader() : mStage((int)LoadStage::Idle)
+    {}
+
+    virtual ~Loader();
+
+    // parallax layer to build from sprite `id` (before `start()`); its index
+    // here is the one for `layer()`
+    void addLayer(SpriteId id, float y, float factor);
+    // also decode `audio`'s sounds (before `start()`)
+    void addAudio(AudioEngine *audio)
+    { this->mAudio = audio; }
+
+    // kick off the CPU work
+    void start();
+
+    // window thread, once per frame until it returns `Done` / `Failed`:
+    // uploads for about `budgetMs`, then fills `texMap` and `parallax`
+    LoadStage update(TextureMap& texMap, Parallax& parallax, double budgetMs = LOADER_BUDGET_MS);
+
+    LoadStage stage() const
+    { return (LoadStage)this->mStage.load(std::memory_order_acquire); }
+
+    // 0..1, for the loading screen
+    float progress() const;
+
+    // `parallax` index of the `i`th `addLayer()` (-1 if it failed)
+    int layer(int i) const
+    { return this->mLayers[i].index; }
+
+private:
+    struct Layer
+    {
+        SpriteId id;
+        float y, factor;
+        Image image;    // from `Parallax::cutOut()`, owned until uploaded
+        int index;
+    };
+
+    void prepare();
+    // one upload / finishing step; false when there's nothing left
+    bool uploadNext(TextureMap& texMap, Parallax& parallax);
+
+    std::atomic<int> mStage;
+#if defined(LOADER_THREAD)
+    std::thread mWorker;
+#endif
+
+    // only mapped while loading
+    AssetPack mPack;
+    Texture2D mPages[PACK_MAX_PAGES];
+
+    Layer mLayers[PARALLAX_MAX_LAYERS];
+    int mNumLayers = 0;
+
+    AudioEngine *mAudio = nullptr;
+
+    // pages, then layers, then the sprite table
+    int mNextUpload = 0;
+};
@@ -0,0 +1,110 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Parallax.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "Parallax.hpp"
+
+
+Image Parallax::cutOut(const Image& atlas, const TextureData& sprite)
+{
+    Image image;
+    image.data = nullptr;
+    if (atlas.format != UNCOMPRESSED_R8G8B8A8)
+        return image;
+
+    // copy the sprite out (the atlas may be a read-only mapping), turning
+    // rotated frames back and padding trimmed ones to their full size
+    Rectf frame = sprite.srcFrame;
+    int left = (int)frame.position.x, top = (int)frame.position.y;
+    if (left < 0 || top < 0 || left + (int)frame.size.width > atlas.width ||
+        top + (int)frame.size.height > atlas.height)
+        return image;
+
+    int w = (int)sprite.size.width, h = (int)sprite.size.height;
+    int ox = (int)sprite.trim.position.x, oy = (int)sprite.trim.position.y;
+    int tw = (int)sprite.trim.size.width, th = (int)sprite.trim.size.height;
+    if (w <= 0 || h <= 0 || ox < 0 || oy < 0 || ox + tw > w || oy + th > h)
+        return image;
+
+    image.data = calloc((size_t)w * h, 4);
+    image.width = w;
+    image.height = h;
+    image.mipmaps = 1;
+    image.format = UNCOMPRESSED_R8G8B8A8;
+
+    const uint32_t *src = (const uint32_t *)atlas.data;
+    uint32_t *dst = (uint32_t *)image.data;
+    for (int ty = 0; ty < th; ty++)
+        for (int tx = 0; tx < tw; tx++)
+        {
+            // turned clockwise, trimmed pixel (tx, ty) is stored at (th-1-ty, tx)
+            int ax = sprite.rotated ? left + th - 1 - ty : left + tx;
+            int ay = sprite.rotated ? top + tx : top + ty;
+            dst[(size_t)(oy + ty) * w + ox + tx] = src[(size_t)ay * atlas.width + ax];
+        }
+
+#if defined(PLATFORM_WEB)
+    // WebGL 1 only repeats power-of-two textures; nearest-neighbour keeps
+    // the pixel art exact when sampled back down with point filtering
+    int potW = (int)Math::roundPow2(w);
+    int potH = (int)Math::roundPow2(h);
+    if (potW != image.width || potH != image.height)
+        ImageResizeNN(&image, potW, potH);
+#endif
+
+    return image;
+}
+
+
+int Parallax::add(Image image, Vec2f size, float y, float factor)
+{
+    if (!image.data)
+        return -1;
+    if (this->numLayers >= PARALLAX_MAX_LAYERS)
+    {
+        UnloadImage(image);
+        return -1;
+    }
+
+    Texture2D tex = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (tex.id == 0)
+        return -1;
+    SetTextureWrap(tex, WRAP_REPEAT);
+
+    ParallaxLayer& layer = this->layers[this->numLayers];
+    layer.tex = tex;
+    layer.size = size;
+    layer.y = y;
+    layer.factor = factor;
+
+    return this->numLayers++;
+}
+
+
+void Parallax::draw(
+    SpriteBatch& batch, int layer, float scroll, const Rectf& view,
+    float zoomScale, Color tint
+) const {
+    if (layer < 0 || layer >= this->numLayers)
+        return;
+
+    const ParallaxLayer& l = this->layers[layer];
+
+    // wrap before dividing so uvs stay small (precise) however far we got
+    float tileX = fmodf(view.left() + scroll * l.factor, l.size.width);
+    if (tileX < 0)
+        tileX += l.size.width;
+
+    Rectf uv(
+        tileX / l.size.width, 0,
+        view.size.width / l.size.width, 1
+    );
+    Rectf destRec(
+        Vec2f(view.left(), l.y) * zoomScale,
+        Vec2f(view.size.width, l.size.height) * zoomScale
+    );
+
+    batch.draw(l.tex, uv, destRec, Vec2f(0), 0, tint);
+}
@@ -0,0 +1,51 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Parallax.hpp
+ * - endlessly scrolling background layers (sky, floor, ...): each layer's
+ *   sprite is copied out of the atlas into its own texture with wrap
+ *   addressing, so a layer is one quad across the whole view whose uvs
+ *   scroll -- constant cost at any zoom / screen width
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include "common.hpp"
+#include "Resource.hpp"
+#include "SpriteBatch.hpp"
+
+
+#define PARALLAX_MAX_LAYERS 4
+
+
+struct ParallaxLayer
+{
+    Texture2D tex;      // the sprite alone, `WRAP_REPEAT`
+    Vec2f size;         // one tile (world px)
+    float y;            // top edge (world px)
+    float factor;       // scroll speed relative to the camera (1 = ground)
+};
+
+
+class Parallax
+{
+public:
+    ParallaxLayer layers[PARALLAX_MAX_LAYERS];
+    int numLayers = 0;
+
+    // CPU half of a layer (any thread): `sprite` copied out of `atlas`
+    // (RGBA8, e.g. `Resource::packImage()`) at its untrimmed size; `data`
+    // is nullptr if it doesn't fit the atlas
+    static Image cutOut(const Image& atlas, const TextureData& sprite);
+
+    // upload `image` (from `cutOut()`, freed here; needs the GL context) as
+    // a layer of `size` world px; returns the layer index, or -1 when full /
+    // the upload failed
+    int add(Image image, Vec2f size, float y, float factor);
+
+    // one quad covering `view` (world px) horizontally; `scroll` is the
+    // camera's world x (e.g. `xOffset`)
+    void draw(
+        SpriteBatch& batch, int layer, float scroll, const Rectf& view,
+        float zoomScale, Color tint = WHITE
+    ) const;
+};
@@ -0,0 +1,48 @@
+/**
+ * -----------------------------------------------------------------------------
+ * RaylibAudio.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "RaylibAudio.hpp"
+
+
+bool RaylibAudioDevice::open(int sampleRate, int& periodFrames)
+{
+    if (!IsAudioDeviceReady())
+        return false;
+
+    periodFrames = RAYLIB_AUDIO_PERIOD;
+    this->mPeriodFrames = periodFrames;
+    this->mStream = InitAudioStream(sampleRate, 16, 2);
+    PlayAudioStream(this->mStream);
+    this->mOpen = true;
+    return true;
+}
+
+int RaylibAudioDevice::available()
+{
+    // one buffer at a time, whenever the stream has played one
+    return IsAudioBufferProcessed(this->mStream) ? this->mPeriodFrames : 0;
+}
+
+int RaylibAudioDevice::queuedFrames()
+{
+    // raylib doesn't say how far into its buffers it is: the one not free
+    // has only just started when the other one is
+    return this->mPeriodFrames;
+}
+
+void RaylibAudioDevice::write(const int16_t *samples, int frames)
+{
+    UpdateAudioStream(this->mStream, samples, frames);
+}
+
+void RaylibAudioDevice::close()
+{
+    if (!this->mOpen)
+        return;
+
+    StopAudioStream(this->mStream);
+    CloseAudioStream(this->mStream);
+    this->mOpen = false;
+}
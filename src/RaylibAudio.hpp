@@ -0,0 +1,39 @@
+/**
+ * -----------------------------------------------------------------------------
+ * RaylibAudio.hpp
+ * - `AudioDevice` (see `core/AudioDevice.hpp`) on a raylib `AudioStream`;
+ *   needs `InitAudioDevice()` first
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include "common.hpp"
+#include "core/AudioDevice.hpp"
+
+
+// raylib 2.x stream buffers are a fixed `AUDIO_BUFFER_SIZE` frames; writing
+// less would play the rest as silence. Two of them, so a sound is heard
+// ~93 ms (one buffer) to ~186 ms (two) after `play()`, plus whatever
+// raylib's own device buffers (see README, "Sound"). raylib 1.8 (OpenAL)
+// sizes each buffer by the write, so a build against it, or against a
+// raylib rebuilt with a smaller `AUDIO_BUFFER_SIZE`, can set e.g.
+// `make RAYLIB_AUDIO_PERIOD=1024`
+#ifndef RAYLIB_AUDIO_PERIOD
+    #define RAYLIB_AUDIO_PERIOD 4096
+#endif
+
+
+class RaylibAudioDevice : public AudioDevice
+{
+public:
+    bool open(int sampleRate, int& periodFrames) override;
+    int available() override;
+    int queuedFrames() override;
+    void write(const int16_t *samples, int frames) override;
+    void close() override;
+
+private:
+    AudioStream mStream;
+    bool mOpen = false;
+    int mPeriodFrames = 0;
+};
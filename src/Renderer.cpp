@@ -5,10 +5,11 @@
  */
 #include <iostream>
 
-#include "rlgl.h"
-
 #include "Renderer.hpp"
 #include "gui.h"
+#include "core/AllocCounter.hpp"
+#include "core/Profiler.hpp"
+#include "core/HudText.hpp"
 
 /**
  * global static vars
@@ -16,115 +17,26 @@
 // static const Color COLOR_BIRD = (Color){255, 255, 255, 255};
 static const Color COLOR_DEBUG = (Color){255, 0, 113, 255};
 
-// TEXTURE KEYS
-static const std::string TEX_BACKGROUND = "background-day";
-static const std::string TEX_PIPE = "pipe-green";
-static const std::string TEX_FLOOR = "base";
-static const std::string TEX_BIRD_0 = "yellowbird-downflap";
-static const std::string TEX_BIRD_1 = "yellowbird-midflap";
-static const std::string TEX_BIRD_2 = "yellowbird-upflap";
-static const std::string TEX_NUM_0 = "num-0";
-static const std::string TEX_NUM_1 = "num-1";
-static const std::string TEX_NUM_2 = "num-2";
-static const std::string TEX_NUM_3 = "num-3";
-static const std::string TEX_NUM_4 = "num-4";
-static const std::string TEX_NUM_5 = "num-5";
-static const std::string TEX_NUM_6 = "num-6";
-static const std::string TEX_NUM_7 = "num-7";
-static const std::string TEX_NUM_8 = "num-8";
-static const std::string TEX_NUM_9 = "num-9";
-
-const std::string& num_char_to_key(char i)
+// SPRITES
+static const SpriteId TEX_BACKGROUND = SpriteId::BackgroundDay;
+static const SpriteId TEX_PIPE = SpriteId::PipeGreen;
+static const SpriteId TEX_FLOOR = SpriteId::Base;
+// bird animation cycle
+static const SpriteId TEX_BIRD[4] = {
+    SpriteId::YellowbirdDownflap,
+    SpriteId::YellowbirdMidflap,
+    SpriteId::YellowbirdUpflap,
+    SpriteId::YellowbirdMidflap,
+};
+
+static_assert((int)SpriteId::Num9 - (int)SpriteId::Num0 == 9, "digit sprites must be contiguous");
+
+SpriteId digit_sprite(int d)
 {
-    assert(i >= '0');
-    assert(i <= '9');
-
-    switch (i)
-    {
-        case '0':
-            return TEX_NUM_0;
-        case '1':
-            return TEX_NUM_1;
-        case '2':
-            return TEX_NUM_2;
-        case '3':
-            return TEX_NUM_3;
-        case '4':
-            return TEX_NUM_4;
-        case '5':
-            return TEX_NUM_5;
-        case '6':
-            return TEX_NUM_6;
-        case '7':
-            return TEX_NUM_7;
-        case '8':
-            return TEX_NUM_8;
-        case '9':
-            return TEX_NUM_9;
-        default:
-            return TEX_NUM_0;
-    }
-}
-
+    assert(d >= 0);
+    assert(d <= 9);
 
-/**
- * Draw a part of a texture (defined by a rectangle) with 'pro' parameters
- * NOTE: origin is relative to destination rectangle size
- * see: raylib's "DrawTexturePro()"
- */
-void my_drawTexture(
-    Texture2D texture,
-    Rectf sourceRec,
-    Rectf destRec,
-    Vec2f origin = Vec2f(0),
-    float rotation = 0,
-    Color tint = WHITE
-) {
-    // Check if texture is valid
-    if (texture.id > 0)
-    {
-        if (sourceRec.size.width < 0) sourceRec.position.x -= sourceRec.size.width;
-        if (sourceRec.size.height < 0) sourceRec.position.y -= sourceRec.size.height;
-
-        rlEnableTexture(texture.id);
-
-        rlPushMatrix();
-            rlTranslatef((float)destRec.position.x, (float)destRec.position.y, 0);
-            rlRotatef(rotation, 0, 0, 1);
-            rlTranslatef(-origin.x, -origin.y, 0);
-
-            rlBegin(RL_QUADS);
-                rlColor4ub(tint.r, tint.g, tint.b, tint.a);
-                rlNormal3f(0.0f, 0.0f, 1.0f);                          // Normal vector pointing towards viewer
-
-                // Bottom-left corner for texture and quad
-                float btm_left_x = (float)sourceRec.position.x/texture.width; 
-                float btm_left_y = (float)sourceRec.position.y/texture.height;
-                rlTexCoord2f(btm_left_x, btm_left_y);
-                rlVertex2f(0.0f, 0.0f);
-
-                // Bottom-right corner for texture and quad
-                float btm_right_x = (float)sourceRec.position.x/texture.width; 
-                float btm_right_y = (float)(sourceRec.position.y + sourceRec.size.height)/texture.height;
-                rlTexCoord2f(btm_right_x, btm_right_y);
-                rlVertex2f(0.0f, (float)destRec.size.height);
-
-                // Top-right corner for texture and quad
-                float top_right_x = (float)(sourceRec.position.x + sourceRec.size.width)/texture.width;
-                float top_right_y = (float)(sourceRec.position.y + sourceRec.size.height)/texture.height;
-                rlTexCoord2f(top_right_x, top_right_y);
-                rlVertex2f((float)destRec.size.width, (float)destRec.size.height);
-
-                // Top-left corner for texture and quad
-                float top_left_x = (float)(sourceRec.position.x + sourceRec.size.width)/texture.width;
-                float top_left_y = (float)sourceRec.position.y/texture.height;
-                rlTexCoord2f(top_left_x, top_left_y);
-                rlVertex2f((float)destRec.size.width, 0.0f);
-            rlEnd();
-        rlPopMatrix();
-
-        rlDisableTexture();
-    }
+    return (SpriteId)((int)SpriteId::Num0 + d);
 }
 
 
@@ -134,12 +46,41 @@ void my_drawTexture(
  */
 void Renderer::init()
 {
-    // load textures
-    this->texMap = Resource::loadTextures();
+    // layers scroll at half speed (sky) / with the pipes (ground)
+    this->loader.addLayer(TEX_BACKGROUND, 0, 0.5);
+    this->loader.addLayer(TEX_FLOOR, floorY, 1);
+    this->loader.start();
+}
+
+Rectf Renderer::worldView(const UiState *state, float zoomScale) const
+{
+    // screen = (world * zoomScale - target) * zoom + offset  (no rotation)
+    Vec2f screen = Vec2f(state->screenWidth, state->screenHeight) * this->platformRenderScale;
+    Vec2f offset(this->camera.offset.x, this->camera.offset.y);
+    Vec2f target(this->camera.target.x, this->camera.target.y);
+    float scale = this->camera.zoom * zoomScale;
+
+    Vec2f topLeft = ((Vec2f(0) - offset) / this->camera.zoom + target) / zoomScale;
+    return Rectf(topLeft, screen / scale);
 }
 
-void Renderer::render(State *state)
+void Renderer::render(const FrameSnapshot& frame, UiState *state)
 {
+    PROFILE_SCOPE("render");
+
+    // assets still loading (see `Loader`)
+    if (!this->loaded())
+    {
+        LoadStage stage = this->loader.update(this->texMap, this->parallax);
+        if (stage != LoadStage::Done)
+        {
+            this->renderLoading(state, stage);
+            return;
+        }
+        this->layerBackground = this->loader.layer(0);
+        this->layerFloor = this->loader.layer(1);
+    }
+
     // update stuff
     if (state->inputState.toggleGui)
         this->guiVisible = !this->guiVisible;
@@ -149,26 +90,77 @@ void Renderer::render(State *state)
     ClearBackground(this->bgColor);
 
     // render entities
-    this->renderEntities(state);
+    this->renderEntities(frame, state);
     
     // render gui
     if (this->guiVisible)
-        this->renderGui(state);
+        this->renderGui(frame, state);
 
     // post-render
-    EndDrawing();            
+    {
+        PROFILE_SCOPE("present");
+        EndDrawing();
+    }            
+}
+
+void Renderer::renderLoading(const UiState *state, LoadStage stage)
+{
+    PROFILE_SCOPE("loading screen");
+
+    int screenWidth = state->screenWidth * this->platformRenderScale;
+    int screenHeight = state->screenHeight * this->platformRenderScale;
+    int fontSize = 20 * this->platformRenderScale;
+
+    BeginDrawing();
+    ClearBackground(this->bgColor);
+
+    const char *text = (stage == LoadStage::Failed) ? "failed to load assets" : "loading...";
+    int textWidth = MeasureText(text, fontSize);
+    DrawText(text, (screenWidth - textWidth) / 2, screenHeight / 2 - fontSize * 2, fontSize, RAYWHITE);
+
+    if (stage != LoadStage::Failed)
+    {
+        int barWidth = screenWidth / 2;
+        int barHeight = fontSize / 2;
+        int x = (screenWidth - barWidth) / 2;
+        int y = screenHeight / 2;
+        DrawRectangleLines(x, y, barWidth, barHeight, RAYWHITE);
+        DrawRectangle(x, y, barWidth * this->loader.progress(), barHeight, RAYWHITE);
+    }
+
+    EndDrawing();
 }
 
-void Renderer::renderEntities(State *state)
+void Renderer::renderEntities(const FrameSnapshot& frame, const UiState *state)
 {
+    PROFILE_SCOPE("entities");
+
     // set camera zoom (this affects everything that is rendered)
     this->camera.zoom = this->zoomCamera ? this->zoomAmount : 1.0;
     Begin2dMode(this->camera);
 
     float zoomScale = (1.0 / this->camera.zoom) * this->platformRenderScale;
+
+    // world rect on screen; sprites outside it are culled by the batch
+    Rectf view = this->worldView(state, zoomScale);
+    Rectf cullRect(view.position * zoomScale, view.size * zoomScale);
+    this->spriteBatch.begin(&cullRect);
     // float scale = 1.0;
 
-    auto& gameState = state->gameState;
+    auto& gameState = frame.gameState;
+
+    /**
+     * interpolate between the last two sim ticks so motion stays smooth at
+     * any refresh rate (no blending across a restart)
+     */
+    auto& prevState = frame.prevGameState;
+    bool sameRun = (
+        prevState.seed == gameState.seed &&
+        prevState.xOffset <= gameState.xOffset
+    );
+    float alpha = sameRun ? state->renderAlpha : 1;
+    float xOffset = Math::lerp(alpha, prevState.xOffset, gameState.xOffset);
+    float birdY = Math::lerp(alpha, prevState.birdY, gameState.birdY);
 
     /**
      * helper fns
@@ -177,6 +169,7 @@ void Renderer::renderEntities(State *state)
      */
     auto draw_rect = [&](Vec2f position, Vec2f size, Color c)
     {
+        this->spriteBatch.flush(); // keep draw order
         DrawRectangleLines(
             (position.x) * zoomScale,
             (position.y) * zoomScale,
@@ -187,6 +180,7 @@ void Renderer::renderEntities(State *state)
     };
     auto draw_rect_centered = [&](Vec2f position, Vec2f size, Color c)
     {
+        this->spriteBatch.flush(); // keep draw order
         DrawRectangleLines(
             (position.x - size.x/2) * zoomScale,
             (position.y - size.y/2) * zoomScale,
@@ -197,6 +191,7 @@ void Renderer::renderEntities(State *state)
     };
     auto draw_circle = [&](Vec2f position, float radius, Color c)
     {
+        this->spriteBatch.flush(); // keep draw order
         DrawCircle(
             position.x * zoomScale,
             position.y * zoomScale,
@@ -208,64 +203,52 @@ void Renderer::renderEntities(State *state)
     /**
      * Render background
      */
-    {
-        auto &texData = this->texMap.find(TEX_BACKGROUND)->second;
-
-        Vec2f size = texData.srcFrame.size;
-        Vec2f position = Vec2f(
-            fmod(-gameState.xOffset / 2, size.width),
-            0
-        );
-        // printlog(1, "w: %d | x: %d", (int)size.width, (int)position.x);
-
-        while (position.x < state->screenWidth)
-        {
-            my_drawTexture(
-                texData.tex,
-                texData.srcFrame,
-                Rectf(position * zoomScale, size * zoomScale),
-                Vec2f(0)
-            );
-
-            position.x += size.width;
-        }
-    }
+    this->parallax.draw(this->spriteBatch, this->layerBackground, xOffset, view, zoomScale);
 
     /**
      * Render pipes 
+     * read from the level stream instead of the sim's ring, so every pipe in
+     * view is drawn however few the sim keeps alive; only the pipes that
+     * can overlap the view horizontally are visited (halves above / below
+     * it are culled by the batch)
      */
-    for (auto& pipe : gameState.pipes)
+    if (this->levelStream.seed() != gameState.seed)
+        this->levelStream.reset(gameState.seed);
+
+    for (int k = LevelStream::firstPipeAfter(xOffset + view.left()); ; k++)
     {
+        Vec2f pipe = this->levelStream.pipe(k);
+        if (pipe.x - xOffset >= view.right())
+            break;
+
         // get texture
-        auto& texData = this->texMap.find(TEX_PIPE)->second;
-        Vec2f size = texData.srcFrame.size;
+        auto& texData = this->sprite(TEX_PIPE);
+        Vec2f size = texData.size;
 
-        auto xPos = pipe.x - gameState.xOffset;
+        auto xPos = pipe.x - xOffset;
 
         auto topPos = Vec2f(xPos, pipe.y - halfGap - size.height);
         auto btmPos = Vec2f(xPos, pipe.y + halfGap);
 
         // top render data
         Rectf topDestRect(topPos * zoomScale, size * zoomScale);
-        auto topSrcFrame = texData.srcFrame;  // NOTE: reverse tex y for top
-        topSrcFrame.size.height *= -1; 
 
         // btm render data
         Rectf btmDestRect(btmPos * zoomScale, size * zoomScale);
 
-        // draw top pipe
-        my_drawTexture(
-            texData.tex,
-            topSrcFrame,
+        // draw top pipe (NOTE: flipped upside down)
+        this->spriteBatch.draw(
+            texData,
             topDestRect,
             Vec2f(0),
-            0
+            0,
+            WHITE,
+            true
         );
         
         // draw btm pipe
-        my_drawTexture(
-            texData.tex,
-            texData.srcFrame,
+        this->spriteBatch.draw(
+            texData,
             btmDestRect,
             Vec2f(0),
             0
@@ -293,83 +276,41 @@ void Renderer::renderEntities(State *state)
     /**
      * Render floor / ground
      */
-    {
-        auto &texData = this->texMap.find(TEX_FLOOR)->second;
-
-        Vec2f size = texData.srcFrame.size;
-        Vec2f position = Vec2f(
-            fmod(-gameState.xOffset, size.width),
-            floorY
-        );
-        // printlog(1, "w: %d | x: %d", (int)size.width, (int)position.x);
-
-        while (position.x < state->screenWidth)
-        {
-            my_drawTexture(
-                texData.tex,
-                texData.srcFrame,
-                Rectf(position * zoomScale, size * zoomScale),
-                Vec2f(0)
-            );
-            position.x += size.width;
-        }
-    }
+    this->parallax.draw(this->spriteBatch, this->layerFloor, xOffset, view, zoomScale);
 
     /**
      * Render bird
      */
     {
-        int frame = (int)(gameState.xOffset / 20) % 4;
-        
-        const string* texKey;
-        switch (frame)
-        {
-            case 0:
-                texKey = &TEX_BIRD_0;
-                break;
-            case 1:
-                texKey = &TEX_BIRD_1;
-                break;
-            case 2:
-                texKey = &TEX_BIRD_2;
-                break;
-            case 3:
-                texKey = &TEX_BIRD_1;
-                break;
-            default:
-                assert(false);
-                break;
-        }
-        
-        auto& texData = this->texMap.find(*texKey)->second;
+        int frame = (int)(xOffset / 20) % 4;
+        auto& texData = this->sprite(TEX_BIRD[frame]);
 
-        Vec2f position = Vec2f(birdX, gameState.birdY) * zoomScale;
-        Vec2f size = texData.srcFrame.size * zoomScale;
+        Vec2f position = Vec2f(birdX, birdY) * zoomScale;
+        Vec2f size = texData.size * zoomScale;
         Rectf destRect(position, size);
         
         Vec2f offset(size / 2);
 
-        // update bird rotation
+        // update bird rotation (smoothed per rendered frame, renderer-side)
         float newRotation = Math::map(
             gameState.birdVY,
             -500, 1100,
             -70, 75 // -67, 67
         );
-        gameState.birdRotation = Math::lerp(0.3, gameState.birdRotation, newRotation);
+        this->birdRotation = Math::lerp(0.3, this->birdRotation, newRotation);
 
-        my_drawTexture(
-            texData.tex,
-            texData.srcFrame,
+        this->spriteBatch.draw(
+            texData,
             destRect,
             offset,
-            gameState.birdRotation 
+            this->birdRotation
         );
 
         if (this->debugDraw)
         {
             // DEBUG: draw shape
             draw_circle(
-                Vec2f(birdX, gameState.birdY),
+                Vec2f(birdX, birdY),
                 birdSize,
                 COLOR_DEBUG
             );
@@ -383,33 +324,29 @@ void Renderer::renderEntities(State *state)
         const Vec2f padding(60, 40);
         const int x_incr = 5; 
 
-        // TODO:
-        // use int division & modulo to get sprites instead of creating this spring
-        auto score_str = std::to_string(gameState.score);
+        int digits[HUD_MAX_DIGITS];
+        int len = Hud::scoreDigits(gameState.score, digits);
 
-        int len = score_str.length();
-        int sprite_width = this->texMap.find(TEX_NUM_0)->second.srcFrame.size.width; 
+        int sprite_width = this->sprite(SpriteId::Num0).size.width; 
         int total_width = len*sprite_width + (len - 1)*x_incr; 
         int x_start = state->screenWidth - padding.x - total_width;
 
 
         Vec2f position(x_start, padding.y);
 
-        for (char c : score_str)
+        for (int i = 0; i < len; i++)
         {
-            auto& numkey = num_char_to_key(c);
-            auto& texData = this->texMap.find(numkey)->second;
+            auto& texData = this->sprite(digit_sprite(digits[i]));
 
-            Vec2f size = texData.srcFrame.size;
+            Vec2f size = texData.size;
 
             Rectf destRect(
                 position * zoomScale,
                 size * zoomScale
             );
 
-            my_drawTexture(
-                texData.tex,
-                texData.srcFrame,
+            this->spriteBatch.draw(
+                texData,
                 destRect,
                 Vec2f(0)
             );
@@ -422,12 +359,15 @@ void Renderer::renderEntities(State *state)
     /**
      * end camera 2d render
      */
+    this->spriteBatch.end();
     End2dMode();
 }
 
 
-void Renderer::renderGui(State *state)
+void Renderer::renderGui(const FrameSnapshot& frame, UiState *state)
 {
+    PROFILE_SCOPE("gui");
+
     // draw cursor sguff
     if (state->inputState.mouseDown)
     {
@@ -441,7 +381,8 @@ void Renderer::renderGui(State *state)
             state->inputState.mousePressedPos.y, 10, col);
     }
 
-    static char guiTextBuf[1000];
+    char guiTextBuf[64];
+    HudText hudText;
 
     // int screenWidth = state->screenWidth;
     int heightText = 15;
@@ -458,15 +399,47 @@ void Renderer::renderGui(State *state)
     /**
      * draw background
      */
-    DrawRectangle(0, 0, width + padding*2, 300, Fade(BLACK, 0.8));
+    DrawRectangle(0, 0, width + padding*2, 460, Fade(BLACK, 0.8));
 
     /**
      * render text
      */
-    sprintf(guiTextBuf, "FPS: %i", state->fps);
     gui_label(
         (Rectangle){ x, yNext, width, heightText },
-        guiTextBuf
+        Hud::fps(hudText, state->fps)
+    );
+    yNext += heightText;
+
+    gui_label(
+        (Rectangle){ x, yNext, width, heightText },
+        Hud::ticks(hudText, frame.ticks, state->renderAlpha)
+    );
+    yNext += heightText;
+
+    if (AllocCounter::enabled())
+    {
+        gui_label(
+            (Rectangle){ x, yNext, width, heightText },
+            Hud::allocs(hudText, state->frameAllocs, frame.simAllocs)
+        );
+        yNext += heightText;
+    }
+
+    yNext += padding;
+
+    /**
+     * render sprite batch counters (this frame, see `SpriteBatch`)
+     */
+    auto& batchStats = this->spriteBatch.stats;
+    gui_label(
+        (Rectangle){ x, yNext, width, heightText },
+        Hud::sprites(hudText, batchStats.sprites, batchStats.culled)
+    );
+    yNext += heightText;
+
+    gui_label(
+        (Rectangle){ x, yNext, width, heightText },
+        Hud::draws(hudText, batchStats.drawCalls, batchStats.vertices)
     );
     yNext += heightText;
 
@@ -476,7 +449,7 @@ void Renderer::renderGui(State *state)
      * render button
      */
     // char *btnTitle = "Can Update";
-    sprintf(guiTextBuf, "Can Update");
+    snprintf(guiTextBuf, sizeof(guiTextBuf), "Can Update");
     state->canUpdate = gui_toggleButton(
         (Rectangle){ x, yNext, width, heightBtn},
         guiTextBuf,
@@ -489,7 +462,7 @@ void Renderer::renderGui(State *state)
      * render button
      */
     // char *btnTitle = "Can Update";
-    sprintf(guiTextBuf, "Debug Draw");
+    snprintf(guiTextBuf, sizeof(guiTextBuf), "Debug Draw");
     this->debugDraw = gui_toggleButton(
         (Rectangle){ x, yNext, width, heightBtn},
         guiTextBuf,
@@ -501,7 +474,7 @@ void Renderer::renderGui(State *state)
     /**
      * render button
      */
-    sprintf(guiTextBuf, "Zoom Camera");
+    snprintf(guiTextBuf, sizeof(guiTextBuf), "Zoom Camera");
     this->zoomCamera = gui_toggleButton(
         (Rectangle){ x, yNext, width, heightBtn},
         guiTextBuf,
@@ -509,13 +482,74 @@ void Renderer::renderGui(State *state)
     );
     yNext += padding + heightBtn;
 
+    /**
+     * render button
+     */
+    snprintf(guiTextBuf, sizeof(guiTextBuf), "Autopilot");
+    state->autopilot = gui_toggleButton(
+        (Rectangle){ x, yNext, width, heightBtn},
+        guiTextBuf,
+        state->autopilot 
+    );
+    yNext += heightBtn;
+
+    if (state->autopilot)
+    {
+        gui_label(
+            (Rectangle){ x, yNext, width, heightText },
+            Hud::plan(hudText, frame.plannerMicros, frame.plannerSurvives)
+        );
+    }
+    yNext += padding + heightText;
+
+    /**
+     * render replay controls (R toggles, S saves)
+     */
+    snprintf(guiTextBuf, sizeof(guiTextBuf), "Replay");
+    state->replaying = gui_toggleButton(
+        (Rectangle){ x, yNext, width, heightBtn},
+        guiTextBuf,
+        state->replaying
+    );
+    yNext += heightBtn;
+
+    if (state->replaying)
+    {
+        snprintf(guiTextBuf, sizeof(guiTextBuf), "Fast");
+        state->replayFast = gui_toggleButton(
+            (Rectangle){ x, yNext, width, heightBtn},
+            guiTextBuf,
+            state->replayFast
+        );
+        yNext += heightBtn;
+
+        gui_label(
+            (Rectangle){ x, yNext, width, heightText },
+            Hud::replayTick(hudText, frame.replayTick, frame.replayLength)
+        );
+        yNext += heightText;
+
+        if (frame.replayLength > 0)
+        {
+            int scrub = (int)gui_sliderBar(
+                (Rectangle){ x, yNext, width, heightSlider },
+                frame.replayTick,
+                0,
+                frame.replayLength
+            );
+            if (scrub != frame.replayTick)
+                state->replaySeek = scrub;
+        }
+        yNext += heightSlider;
+    }
+    yNext += padding;
+
     /**
      * render slider  
      */
-    sprintf(guiTextBuf, "Zoom Amount: %.2f", this->zoomAmount);
     gui_label(
         (Rectangle){ x, yNext, width, heightText },
-        guiTextBuf // sliderTitle
+        Hud::zoom(hudText, this->zoomAmount) // sliderTitle
     );
     yNext += heightText;                
 
@@ -527,10 +561,56 @@ void Renderer::renderGui(State *state)
     );
     yNext += padding + heightSlider;                
 
+    /**
+     * render profiler breakdown (avg ms per call over the last 0.5 s, P
+     * exports a trace), in its own panel on the right
+     */
+    if (Profiler::enabled())
+    {
+        ProfileStat stats[16];
+        int numStats = Profiler::summarize(500, stats, 16);
+
+        int numThreads = 0;
+        for (int i = 0; i < numStats; i++)
+            numThreads += (i == 0 || stats[i].thread != stats[i - 1].thread);
+
+        int panelWidth = 140;
+        int px = state->screenWidth * this->platformRenderScale - panelWidth - padding;
+        int py = padding;
+        int lines = 1 + numThreads + numStats;
+        DrawRectangle(px - padding, 0, panelWidth + padding*2, padding*2 + heightText * lines, Fade(BLACK, 0.8));
+
+        snprintf(guiTextBuf, sizeof(guiTextBuf), "Profile (ms, P: trace)");
+        gui_label(
+            (Rectangle){ px, py, panelWidth, heightText },
+            guiTextBuf
+        );
+        py += heightText;
+
+        for (int i = 0; i < numStats; i++)
+        {
+            auto& stat = stats[i];
+            if (i == 0 || stat.thread != stats[i - 1].thread)
+            {
+                gui_label(
+                    (Rectangle){ px, py, panelWidth, heightText },
+                    Hud::profileThread(hudText, Profiler::threadName(stat.thread), stat.thread)
+                );
+                py += heightText;
+            }
+
+            gui_label(
+                (Rectangle){ px, py, panelWidth, heightText },
+                Hud::profileStat(hudText, stat.depth, stat.name, stat.avgMs())
+            );
+            py += heightText;
+        }
+    }
+
     // /**
     //  * render slider  
     //  */
-    // sprintf(guiTextBuf, "playerSpeed: %.2f", state->playerSpeed);
+    // snprintf(guiTextBuf, sizeof(guiTextBuf), "playerSpeed: %.2f", state->playerSpeed);
     // gui_label(
     //     (Rectangle){ x, yNext, width, heightText },
     //     guiTextBuf // sliderTitle
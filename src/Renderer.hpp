@@ -9,6 +9,10 @@
 #include "common.hpp"
 #include "State.hpp"
 #include "Resource.hpp"
+#include "SpriteBatch.hpp"
+#include "Parallax.hpp"
+#include "Loader.hpp"
+#include "core/LevelStream.hpp"
 
 
 
@@ -16,6 +20,15 @@ class Renderer
 {
 public:
     TextureMap texMap;
+    SpriteBatch spriteBatch;
+
+    // fills `texMap` / `parallax` while the first frames show progress
+    Loader loader;
+
+    // scrolling sky / ground (see `init()`)
+    Parallax parallax;
+    int layerBackground = -1;
+    int layerFloor = -1;
 
     Color bgColor = { 25, 25, 25, 255 };
     Camera2D camera;
@@ -26,6 +39,12 @@ public:
     bool guiVisible = false;
     bool debugDraw = false;
 
+    // smoothed towards the bird's velocity every rendered frame
+    float birdRotation = 0;
+
+    // pipes of the level on screen (see `renderEntities()`)
+    LevelStream levelStream;
+
     // constructor
     Renderer()
     {
@@ -48,8 +67,22 @@ public:
         printlog(0, "destroying Renderer\n");
     }
 
+    const TextureData& sprite(SpriteId id) const
+    { return this->texMap[(int)id]; }
+
+    // starts loading the assets; nothing but the loading screen is drawn
+    // until `loaded()`
     void init();
-    void render(State *state);
-    void renderEntities(State *state);
-    void renderGui(State *state);
+    bool loaded() const
+    { return this->loader.stage() == LoadStage::Done; }
+
+    // world rect (px) the camera shows on a `state->screenWidth` x
+    // `state->screenHeight` screen (accounts for zoom / platform scale)
+    Rectf worldView(const UiState *state, float zoomScale) const;
+
+    // draws `frame` (never modified); `state` takes gui / input changes
+    void render(const FrameSnapshot& frame, UiState *state);
+    void renderLoading(const UiState *state, LoadStage stage);
+    void renderEntities(const FrameSnapshot& frame, const UiState *state);
+    void renderGui(const FrameSnapshot& frame, UiState *state);
 };
\ No newline at end of file
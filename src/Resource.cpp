@@ -4,11 +4,6 @@
  * -----------------------------------------------------------------------------
  */
 #include <stdlib.h>
-#include <vector>
-#include <iostream>
-#include <fstream>
-
-#include "json.hpp"
 
 #include "common.hpp"
 #include "Resource.hpp"
@@ -27,58 +22,41 @@ void Resource::loadConfig(const char *path)
 
 
 
-TextureMap Resource::loadTextures()
+Image Resource::packImage(const AssetPack& pack, int page)
 {
-    using namespace std;
-    using nlohmann::json;
-
-    TextureMap texMap;
-
-    // load png
-    Texture2D atlas = LoadTexture("resources/production/textures.png");
-    
-    // load json
-    ifstream i("resources/production/textures.json");
-
-    // put data into json struct
-    json j;
-    i >> j;
-    // // write prettified json
-    // cout
-    // // << setw(4) << j
-    // << endl;
-    auto frames = j["frames"];
-
-    for (auto frame = frames.begin(); frame != frames.end(); ++frame) {
-        string key = frame.key();
-        auto f = frame.value()["frame"];
-
-        auto x = f["x"];
-        auto y = f["y"];
-        auto w = f["w"];
-        auto h = f["h"];
-        // std::cout << frame.key() << " : " << frame.value() << "\n";
-        // std::cout << "x: " << x << " y: " << y << " w: " << w << " h: " <<  h  << "\n" << endl;
-
-        TextureData td;
-        td.key = key;
-        td.tex = atlas;
-        td.srcFrame = Rectf(x, y, w, h);
+    Image image;
+    image.data = (void *)pack.pixels(page);
+    image.width = pack.page(page).width;
+    image.height = pack.page(page).height;
+    image.mipmaps = 1;
+    image.format = UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
 
-        TextureMapEntry entry(key, td);
 
-        texMap.insert(entry);
-    }
+bool Resource::checkSprites(const AssetPack& pack)
+{
+    // the pack and `Sprites.hpp` are both generated from the same atlas;
+    // if they disagree one of them is stale
+    bool matches = (pack.spriteCount() == SPRITE_COUNT);
+    for (int i = 0; matches && i < SPRITE_COUNT; i++)
+        matches = (strcmp(pack.sprite(i).key, SPRITE_KEYS[i]) == 0);
+    if (!matches)
+        printlog(2, "asset pack doesn't match the sprite table (stale '%s'?)", TEXTURE_PACK_PATH);
+    return matches;
+}
 
-    // for (auto& entry : texMap)
-    // {
-    //     // TODO: switch to log printing?
-    //     cout
-    //     << "TextureData loaded: "
-    //     << entry.first 
-    //     << endl;
-    // }
 
-    return texMap;
+TextureData Resource::spriteData(const AssetPack& pack, SpriteId id, Texture2D page)
+{
+    auto& s = pack.sprite((int)id);
+
+    TextureData td;
+    td.tex = page;
+    td.srcFrame = Rectf(s.x, s.y, s.w, s.h);
+    td.uv = Rectf(s.u, s.v, s.uw, s.vh);
+    td.size = Vec2f(s.sw, s.sh);
+    td.rotated = (s.rotated != 0);
+    td.trim = td.rotated ? Rectf(s.ox, s.oy, s.h, s.w) : Rectf(s.ox, s.oy, s.w, s.h);
+    return td;
 }
-
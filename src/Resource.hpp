@@ -5,10 +5,15 @@
  */
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <array>
 
 #include "common.hpp"
+#include "core/AssetPack.hpp"
+#include "Sprites.hpp" // generated from `textures.json` (see `spritegen`)
+
+
+// baked from `textures.json` + `textures.png` by `packer` (see `Makefile`)
+#define TEXTURE_PACK_PATH "resources/production/textures.pack"
 
 
 /**
@@ -18,12 +23,15 @@
 
 struct TextureData
 {
-    std::string key;
     Texture2D tex;
-    Rectf srcFrame;
+    Rectf srcFrame; // px covered in the atlas (swapped if `rotated`)
+    Rectf uv;       // `srcFrame` in normalized texture coordinates
+    Vec2f size;     // untrimmed sprite (px), use this for layout
+    Rectf trim;     // the stored pixels within the untrimmed sprite (px)
+    bool rotated;   // stored turned 90 degrees clockwise
 };
-using TextureMap = std::unordered_map<std::string, TextureData>;
-using TextureMapEntry = std::pair<std::string, TextureData>;
+// indexed by `SpriteId`
+using TextureMap = std::array<TextureData, SPRITE_COUNT>;
 
 
 /**
@@ -34,5 +42,12 @@ class Resource
 {
 public:
     static void loadConfig(const char *path);
-    static TextureMap loadTextures();
+
+    // page `page` of `pack` as an RGBA8 `Image` pointing into the mapping
+    // (read-only, never `UnloadImage()` it)
+    static Image packImage(const AssetPack& pack, int page);
+    // `pack` holds the sprites of `Sprites.hpp`, in `SpriteId` order
+    static bool checkSprites(const AssetPack& pack);
+    // sprite `id` of `pack`, drawn from `page` (its uploaded page)
+    static TextureData spriteData(const AssetPack& pack, SpriteId id, Texture2D page);
 };
\ No newline at end of file
@@ -0,0 +1,203 @@
+/**
+ * -----------------------------------------------------------------------------
+ * SpriteBatch.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <math.h>
+#include <string.h>
+#include <utility>
+
+#include "rlgl.h"
+
+#include "SpriteBatch.hpp"
+
+
+SpriteBatch::SpriteBatch()
+{
+    // persistent: never reallocates after construction
+    this->vertices.reserve(SPRITE_BATCH_MAX_QUADS * 4);
+}
+
+
+void SpriteBatch::begin(const Rectf *cullRect)
+{
+    this->stats = Stats();
+    if (cullRect)
+        this->culler.begin(*cullRect);
+    else
+        this->culler.disable();
+    this->vertices.clear();
+    this->textureId = 0;
+    this->pendingQuads = 0;
+}
+
+
+void SpriteBatch::end()
+{
+    this->flush();
+}
+
+
+void SpriteBatch::draw(
+    Texture2D texture,
+    Rectf uv,
+    Rectf destRec,
+    Vec2f origin,
+    float rotation,
+    Color tint
+) {
+    // quad corners relative to `origin`, in the same order (and with the same
+    // uv mapping) as the old per-sprite `rlBegin(RL_QUADS)` path
+    float x0 = -origin.x;
+    float y0 = -origin.y;
+    float x1 = x0 + destRec.size.width;
+    float y1 = y0 + destRec.size.height;
+
+    float px[4] = { x0, x0, x1, x1 };
+    float py[4] = { y0, y1, y1, y0 };
+    float pu[4] = { uv.left(), uv.left(), uv.right(), uv.right() };
+    float pv[4] = { uv.top(), uv.bottom(), uv.bottom(), uv.top() };
+
+    this->push(texture, destRec.position, px, py, pu, pv, rotation, tint);
+}
+
+
+void SpriteBatch::draw(
+    const TextureData& sprite,
+    Rectf destRec,
+    Vec2f origin,
+    float rotation,
+    Color tint,
+    bool flipY
+) {
+    if (sprite.size.width <= 0 || sprite.size.height <= 0)
+        return;
+
+    // the trimmed pixels' place within `destRec`
+    float sx = destRec.size.width / sprite.size.width;
+    float sy = destRec.size.height / sprite.size.height;
+    Rectf trim = sprite.trim;
+    if (flipY)
+        trim.position.y = sprite.size.height - trim.bottom();
+
+    float x0 = trim.left() * sx - origin.x;
+    float y0 = trim.top() * sy - origin.y;
+    float x1 = trim.right() * sx - origin.x;
+    float y1 = trim.bottom() * sy - origin.y;
+
+    float px[4] = { x0, x0, x1, x1 };
+    float py[4] = { y0, y1, y1, y0 };
+
+    // where the sprite's corners are in its atlas rect; turned clockwise,
+    // its top-left corner ends up top-right
+    const Rectf& uv = sprite.uv;
+    float pu[4] = { uv.left(), uv.left(), uv.right(), uv.right() };
+    float pv[4] = { uv.top(), uv.bottom(), uv.bottom(), uv.top() };
+    if (sprite.rotated)
+    {
+        float ru[4] = { uv.right(), uv.left(), uv.left(), uv.right() };
+        float rv[4] = { uv.top(), uv.top(), uv.bottom(), uv.bottom() };
+        memcpy(pu, ru, sizeof(pu));
+        memcpy(pv, rv, sizeof(pv));
+    }
+    if (flipY)
+    {
+        std::swap(pu[0], pu[1]);
+        std::swap(pv[0], pv[1]);
+        std::swap(pu[2], pu[3]);
+        std::swap(pv[2], pv[3]);
+    }
+
+    this->push(sprite.tex, destRec.position, px, py, pu, pv, rotation, tint);
+}
+
+
+void SpriteBatch::push(
+    Texture2D texture, Vec2f position,
+    const float px[4], const float py[4], const float pu[4], const float pv[4],
+    float rotation, Color tint
+) {
+    // Check if texture is valid
+    if (texture.id == 0)
+        return;
+
+    float c = 1;
+    float s = 0;
+    if (rotation != 0) {
+        c = cosf(rotation * DEG2RAD);
+        s = sinf(rotation * DEG2RAD);
+    }
+
+    float vx[4], vy[4];
+    for (int i = 0; i < 4; i++)
+    {
+        vx[i] = position.x + px[i]*c - py[i]*s;
+        vy[i] = position.y + px[i]*s + py[i]*c;
+    }
+
+    // cull on the transformed quad's bounds (exact for rotated sprites too)
+    float minX = fminf(fminf(vx[0], vx[1]), fminf(vx[2], vx[3]));
+    float maxX = fmaxf(fmaxf(vx[0], vx[1]), fmaxf(vx[2], vx[3]));
+    float minY = fminf(fminf(vy[0], vy[1]), fminf(vy[2], vy[3]));
+    float maxY = fmaxf(fmaxf(vy[0], vy[1]), fmaxf(vy[2], vy[3]));
+    if (!this->culler.visible(minX, minY, maxX, maxY)) {
+        this->stats.culled++;
+        return;
+    }
+
+    if (texture.id != this->textureId) {
+        this->flush();
+        this->textureId = texture.id;
+    }
+    else if ((int)this->vertices.size() >= SPRITE_BATCH_MAX_QUADS * 4) {
+        this->flush();
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        SpriteVertex vtx;
+        vtx.x = vx[i];
+        vtx.y = vy[i];
+        vtx.u = pu[i];
+        vtx.v = pv[i];
+        vtx.color = tint;
+        this->vertices.push_back(vtx);
+    }
+
+    this->stats.sprites++;
+}
+
+
+void SpriteBatch::flush()
+{
+    int count = (int)this->vertices.size();
+    if (count == 0)
+        return;
+
+    // rlgl only draws its buffers at the end of the frame (or 2d mode);
+    // make it draw before our quads would overflow them
+    int quads = count / 4;
+    if (this->pendingQuads + quads > SPRITE_BATCH_MAX_QUADS) {
+        rlglDraw();
+        this->pendingQuads = 0;
+    }
+
+    rlEnableTexture(this->textureId);
+    rlBegin(RL_QUADS);
+        // NOTE: rlgl keeps one color per vertex and only pads missing ones
+        // at `rlEnd()`, so the color goes with every vertex
+        for (const SpriteVertex& vtx : this->vertices)
+        {
+            rlColor4ub(vtx.color.r, vtx.color.g, vtx.color.b, vtx.color.a);
+            rlTexCoord2f(vtx.u, vtx.v);
+            rlVertex2f(vtx.x, vtx.y);
+        }
+    rlEnd();
+    rlDisableTexture();
+
+    this->pendingQuads += quads;
+    this->stats.vertices += count;
+    this->stats.drawCalls++;
+
+    this->vertices.clear();
+}
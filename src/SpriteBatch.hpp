@@ -0,0 +1,97 @@
+/**
+ * -----------------------------------------------------------------------------
+ * SpriteBatch.hpp
+ * - collects textured quads (transformed on the CPU) into one persistent
+ *   vertex buffer and submits them to rlgl in a single draw per texture,
+ *   instead of a matrix push / begin / end round trip per sprite
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <vector>
+
+#include "common.hpp"
+#include "Resource.hpp"
+
+
+// quads buffered before a forced flush; keeps every submission within
+// rlgl's quad buffer on all platforms (`MAX_QUADS_BATCH` is 1024 on ES2)
+#define SPRITE_BATCH_MAX_QUADS 1024
+
+
+struct SpriteVertex
+{
+    float x, y;
+    float u, v;
+    Color color;
+};
+
+
+class SpriteBatch
+{
+public:
+    struct Stats
+    {
+        int sprites = 0;    // drawn
+        int culled = 0;     // skipped, outside the cull rect
+        int vertices = 0;
+        int drawCalls = 0;  // flushes that submitted anything
+    };
+
+    // counters of the current frame (since `begin()`)
+    Stats stats;
+
+    SpriteBatch();
+
+    // `cullRect` (same space as the `destRec`s, nullptr = no culling):
+    // sprites whose transformed quad misses it are skipped
+    void begin(const Rectf *cullRect = nullptr);
+    void end();
+
+    /**
+     * queue `uv` (normalized; negative width / height flips) of `texture`
+     * into `destRec`, rotated by `rotation` degrees around `origin`
+     * (relative to `destRec`) -- same parameters as raylib's `DrawTexturePro()`
+     */
+    void draw(
+        Texture2D texture,
+        Rectf uv,
+        Rectf destRec,
+        Vec2f origin = Vec2f(0),
+        float rotation = 0,
+        Color tint = WHITE
+    );
+
+    /**
+     * queue an atlas sprite so that its untrimmed size fills `destRec`;
+     * trimmed / rotated frames are offset / turned back to match, `flipY`
+     * mirrors it vertically
+     */
+    void draw(
+        const TextureData& sprite,
+        Rectf destRec,
+        Vec2f origin = Vec2f(0),
+        float rotation = 0,
+        Color tint = WHITE,
+        bool flipY = false
+    );
+
+    // submit everything queued so far (call before drawing anything that
+    // doesn't go through the batch, so draw order is kept)
+    void flush();
+
+private:
+    // quad corners (top-left, bottom-left, bottom-right, top-right) relative
+    // to `position`, before rotating them by `rotation` degrees
+    void push(
+        Texture2D texture, Vec2f position,
+        const float px[4], const float py[4], const float pu[4], const float pv[4],
+        float rotation, Color tint
+    );
+
+    std::vector<SpriteVertex> vertices;
+    ViewCuller culler;
+    unsigned int textureId = 0;
+    // quads handed to rlgl since its buffers were last drawn
+    int pendingQuads = 0;
+};
@@ -1,95 +1,98 @@
 /**
  * -----------------------------------------------------------------------------
  * State.hpp
+ * - the sim and the window run on separate threads (see `main.cpp`):
+ *   - `State`: sim thread only
+ *   - `FrameSnapshot`: published by the sim, read-only for the renderer
+ *   - `SimControls`: requests from the window thread to the sim
+ *   - `UiState` / `InputState`: window thread only
  * -----------------------------------------------------------------------------
  */
 #pragma once
 
-#include <vector>
+#include <atomic>
 
-#include "common.hpp"
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+#include "core/Audio.hpp"
 
 using namespace std;
 
 
-/**
- * SEE: https://github.com/bsansouci/reprocessing-example/tree/livestream-flappybird 
- */
-
-// constants
-const float jumpForce = -500.;
-const float speed = 175.;
-const float pipeWidth = 50.;
-const float halfGap = 70.; 
-const float birdSize = 15.; // 20.; // bird radius
-const float gravity = 1400.;
-const float birdX = 50.;
-const float defaultBirdY = 50.;
-// const float pipeHeight = 350.; // TODO: UNUSED; REMOVE
-const float floorY = 500.;
-
-
-enum class RunningT {
-    Running,
-    Dead,
-    Restart,
-};
-
-
-
-class GameState
+class InputState
 {
 public:
-    RunningT running = RunningT::Running;
-    int score = 0;
-    float birdY = defaultBirdY;
-    float birdVY = 0.;
-    float xOffset = 0;
-    float birdRotation = 0; // handled / updated by renderer only
-    vector<Vec2f> pipes = {
-        Vec2f(0), 
-        Vec2f(0), 
-        Vec2f(0), 
-        Vec2f(0), 
-    };
+    bool mousePressed = false;
+    bool mouseDown = false;
+    Vec2f mousePressedPos;
+    Vec2f mouseDragPos;
+    Vec2f mousePos;
+    bool toggleGui = false;
+    bool toggleReplay = false;
+    bool saveReplay = false;
+    bool exportTrace = false;
+};
 
-    // constructor
-    GameState()
-    {
-        printlog(0, "creating GameState");
-
-        // generate pipes
-        int pipeX = 500;
-        int incr = 200;
-        for (auto& pipe : this->pipes)
-        {
-            pipe.x = pipeX;
-            pipe.y = 150;
-
-            pipeX += incr;
-            // printlog(0, "pipe<%f, %f>", pipe.x, pipe.y);
-        }
-    }
 
-    // destructor
-    virtual ~GameState()
+/**
+ * everything the renderer needs from one sim update; immutable once
+ * published
+ */
+struct FrameSnapshot
+{
+    GameState gameState = GameState();
+    GameState prevGameState = GameState(); // state one tick before `gameState`
+
+    // wall time of the update and the sim time left over after its last
+    // tick; `timeScale` is sim seconds per wall second (0 = clock stopped)
+    double time = 0;
+    float accumulator = 0;
+    float timeScale = 0;
+
+    int ticks = 0;              // ticks run by the update
+    int plannerMicros = 0;
+    bool plannerSurvives = false;
+    bool replaying = false;
+    int replayTick = 0;
+    int replayLength = 0;
+    int simAllocs = 0;          // heap allocations of the update (debug builds)
+
+    // how far the view is between `prevGameState` and `gameState` [0, 1]
+    // at wall time `now`
+    float alpha(double now) const
     {
-        printlog(0, "destroying GameState");
+        float t = this->accumulator + (float)(now - this->time) * this->timeScale;
+        return Math::clamp(t / DELTA_TIME, 0, 1);
     }
 };
 
-class InputState
+
+/**
+ * window thread -> sim: settings are mirrored every frame, one-shot
+ * requests are consumed by the sim with an `exchange()`
+ */
+class SimControls
 {
 public:
-    bool mousePressed = false;
-    bool mouseDown = false;
-    Vec2f mousePressedPos;
-    Vec2f mouseDragPos;
-    Vec2f mousePos;
-    bool toggleGui = false;
+    std::atomic<bool> canUpdate;
+    std::atomic<bool> autopilot;
+    std::atomic<bool> replaying;
+    std::atomic<bool> replayFast;
+
+    std::atomic<int> presses;       // flap presses not yet seen by the sim
+    std::atomic<int> replaySeek;    // tick to jump to, -1 = none
+    std::atomic<bool> saveReplay;
+
+    SimControls()
+        : canUpdate(true), autopilot(false), replaying(false), replayFast(false),
+          presses(0), replaySeek(-1), saveReplay(false)
+    {}
 };
 
 
+/**
+ * sim thread state
+ */
 class State
 {
 public:
@@ -99,18 +102,33 @@ public:
     // default is 1; the higher the number,
     // the slower the game (for debugging mostly)
     int ticksPerUpdate = 1; // 2;
-    
-    // timing-related stuff
-    int tick = 0;
-    float frameTime = 0;
-    int fps = 0;
 
-    // screen
-    int screenWidth = SCREEN_W;
-    int screenHeight = SCREEN_H;
+    // let the `Planner` play (see `App::planner`)
+    bool autopilot = false;
+    int plannerBudgetMicros = 1000;
+    int plannerMicros = 0;
+    bool plannerSurvives = false;
+
+    // watch the recorded session (see `App::recorder` / `App::player`)
+    bool replaying = false;
+    bool replayFast = false;    // uncapped instead of 1x
+    int replayTick = 0;
+    int replayLength = 0;
+
+    // fixed-step sim clock: real time is added to `accumulator` and
+    // drained in whole `DELTA_TIME` ticks (at most `maxTicksPerFrame`)
+    double lastTime = 0;
+    float accumulator = 0;
+    int maxTicksPerFrame = 5;
+    int ticksThisFrame = 0;
+    // press seen between ticks; applied on the next tick
+    bool pendingPress = false;
 
-    InputState inputState;
     GameState gameState = GameState();
+    GameState prevGameState = GameState(); // state one tick before `gameState`
+
+    // sounds of live ticks go here (see `Game::update()`)
+    AudioEngine *audio = nullptr;
 
     // constructor
     State()
@@ -123,4 +141,36 @@ public:
     {
         printlog(0, "destroying State");
     }
-};
\ No newline at end of file
+};
+
+
+/**
+ * window thread state: input, gui and what the gui asks of the sim
+ */
+class UiState
+{
+public:
+    // timing-related stuff
+    int tick = 0;
+    float frameTime = 0;
+    int fps = 0;
+    // heap allocations of the last frame (debug builds, see `AllocCounter`)
+    int frameAllocs = 0;
+
+    // interpolation between the snapshot's last two ticks (see
+    // `FrameSnapshot::alpha()`)
+    float renderAlpha = 1;
+
+    // screen
+    int screenWidth = SCREEN_W;
+    int screenHeight = SCREEN_H;
+
+    InputState inputState;
+
+    // mirrored into `SimControls` after every frame
+    bool canUpdate = true;
+    bool autopilot = false;
+    bool replaying = false;
+    bool replayFast = false;
+    int replaySeek = -1;        // set by the scrubber
+};
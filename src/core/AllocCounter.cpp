@@ -0,0 +1,67 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AllocCounter.cpp
+ * - replaces the global `operator new` / `delete` (malloc / free based) in
+ *   debug builds; nothing is replaced otherwise
+ * -----------------------------------------------------------------------------
+ */
+#include <atomic>
+#include <new>
+
+#include "core/AllocCounter.hpp"
+
+
+#if DEBUG
+
+static std::atomic<uint64_t> gAllocs(0);
+static thread_local uint64_t tAllocs = 0;
+
+static void *counted_alloc(size_t size)
+{
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    tAllocs++;
+    return malloc(size ? size : 1);
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = counted_alloc(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    void *ptr = counted_alloc(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept { free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept { free(ptr); }
+
+bool AllocCounter::enabled() { return true; }
+uint64_t AllocCounter::count() { return tAllocs; }
+uint64_t AllocCounter::total() { return gAllocs.load(std::memory_order_relaxed); }
+
+#else
+
+bool AllocCounter::enabled() { return false; }
+uint64_t AllocCounter::count() { return 0; }
+uint64_t AllocCounter::total() { return 0; }
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AllocCounter.hpp
+ * - counts heap allocations made through the global `operator new` (debug
+ *   builds only, see `DEBUG`), so a code path can be checked to be
+ *   allocation-free: sample `count()` before and after it
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "core/core.hpp"
+
+
+class AllocCounter
+{
+public:
+    // false in release builds: the counters stay at 0
+    static bool enabled();
+
+    // allocations made by the calling thread so far
+    static uint64_t count();
+
+    // allocations made by all threads so far
+    static uint64_t total();
+};
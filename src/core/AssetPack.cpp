@@ -0,0 +1,140 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AssetPack.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/AssetPack.hpp"
+
+
+// [offset, offset + size) lies within a file of `fileSize` bytes
+static bool in_file(uint64_t offset, uint64_t size, uint64_t fileSize)
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+
+bool AssetPack::open(const char *path)
+{
+    this->close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printlog(1, "pack: cannot open '%s'", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PackHeader))
+    {
+        printlog(1, "pack: '%s' is truncated", path);
+        ::close(fd);
+        return false;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        printlog(1, "pack: cannot map '%s'", path);
+        return false;
+    }
+
+    this->mMapped = true;
+    return this->attach((const uint8_t *)data, (size_t)st.st_size, path);
+}
+
+
+bool AssetPack::openEmbedded()
+{
+    this->close();
+
+#if EMBED_ASSETS
+    return this->attach((const uint8_t *)EMBEDDED_PACK, EMBEDDED_PACK_SIZE, "<embedded>");
+#else
+    printlog(1, "pack: not built with EMBED_ASSETS");
+    return false;
+#endif
+}
+
+
+bool AssetPack::attach(const uint8_t *data, size_t size, const char *name)
+{
+    this->mData = data;
+    this->mSize = size;
+
+    if (size < sizeof(PackHeader))
+    {
+        printlog(1, "pack: '%s' is truncated", name);
+        this->close();
+        return false;
+    }
+
+    const PackHeader *header = (const PackHeader *)this->mData;
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION)
+    {
+        printlog(1, "pack: '%s' is not an asset pack for this build", name);
+        this->close();
+        return false;
+    }
+    if (header->fileSize != this->mSize || header->pageCount > PACK_MAX_PAGES ||
+        !in_file(header->spriteOffset, (uint64_t)header->spriteCount * sizeof(PackSprite), this->mSize) ||
+        !in_file(header->pageOffset, (uint64_t)header->pageCount * sizeof(PackPage), this->mSize) ||
+        header->spriteOffset % alignof(PackSprite) != 0 ||
+        header->pageOffset % alignof(PackPage) != 0)
+    {
+        printlog(1, "pack: '%s' has a bad header", name);
+        this->close();
+        return false;
+    }
+
+    const PackSprite *sprites = (const PackSprite *)(this->mData + header->spriteOffset);
+    const PackPage *pages = (const PackPage *)(this->mData + header->pageOffset);
+
+    for (uint32_t i = 0; i < header->pageCount; i++)
+    {
+        const PackPage& p = pages[i];
+        if (p.format != PACK_FORMAT_RGBA8 || p.size != (uint64_t)p.width * p.height * 4 ||
+            !in_file(p.offset, p.size, this->mSize))
+        {
+            printlog(1, "pack: '%s': bad page %u", name, i);
+            this->close();
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->spriteCount; i++)
+    {
+        const PackSprite& s = sprites[i];
+        if (s.page >= header->pageCount || memchr(s.key, 0, PACK_KEY_SIZE) == nullptr)
+        {
+            printlog(1, "pack: '%s': bad sprite %u", name, i);
+            this->close();
+            return false;
+        }
+    }
+
+    this->mHeader = header;
+    this->mSprites = sprites;
+    this->mPages = pages;
+    return true;
+}
+
+
+void AssetPack::close()
+{
+    if (this->mMapped)
+        munmap((void *)this->mData, this->mSize);
+
+    this->mData = nullptr;
+    this->mMapped = false;
+    this->mSize = 0;
+    this->mHeader = nullptr;
+    this->mSprites = nullptr;
+    this->mPages = nullptr;
+}
@@ -0,0 +1,127 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AssetPack.hpp
+ * - read-only, memory-mapped asset pack written offline by `tools/packer`:
+ *   the sprite table and the atlas pixels are stored exactly as the game
+ *   uses them, so loading is an `mmap()` plus a few bounds checks -- no
+ *   JSON parsing, no PNG decoding, no copies before the GPU upload
+ *
+ * file layout (host byte order, i.e. little endian on every target):
+ *   PackHeader
+ *   sprite table:  `spriteCount` x PackSprite (`SpriteId` order, i.e.
+ *                  sorted by key)
+ *   page table:    `pageCount` x PackPage
+ *   pixel pages:   raw RGBA8 rows, each page `PACK_PAGE_ALIGN`ed
+ *
+ * with `EMBED_ASSETS` (`make EMBED_ASSETS=1`) the same bytes are compiled
+ * into the executable (see `tools/embedgen`) and `openEmbedded()` uses them
+ * in place: no file, no working directory / web preload requirements
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "core/core.hpp"
+
+
+#ifndef EMBED_ASSETS
+    #define EMBED_ASSETS 0
+#endif
+
+#define PACK_MAGIC          0x4b415046 // "FPAK"
+#define PACK_VERSION        2
+#define PACK_PAGE_ALIGN     4096 // pixel data offsets (mapping page size)
+#define PACK_KEY_SIZE       32
+#define PACK_MAX_PAGES      4
+
+#define PACK_FORMAT_RGBA8   1
+
+
+struct PackHeader
+{
+    uint32_t magic = PACK_MAGIC;
+    uint32_t version = PACK_VERSION;
+    uint32_t spriteCount = 0;
+    uint32_t pageCount = 0;
+    uint32_t spriteOffset = 0;  // sprite table (bytes from the file start)
+    uint32_t pageOffset = 0;    // page table
+    uint64_t fileSize = 0;      // catches truncated packs
+};
+
+struct PackSprite
+{
+    char key[PACK_KEY_SIZE];    // atlas key, 0 terminated
+    uint32_t page;
+    // rect the sprite occupies in its page (px; `h` x `w` of the trimmed
+    // sprite if `rotated`)
+    float x, y, w, h;
+    // the same rect normalized to [0, 1] texture coordinates
+    float u, v, uw, vh;
+    // trimmed pixels start at (`ox`, `oy`) in the untrimmed `sw` x `sh`
+    // sprite (px)
+    float ox, oy, sw, sh;
+    // stored turned 90 degrees clockwise
+    uint32_t rotated;
+};
+
+struct PackPage
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;            // `PACK_FORMAT_*`
+    uint32_t reserved;
+    uint64_t offset;            // pixel data (bytes from the file start)
+    uint64_t size;
+};
+
+static_assert(sizeof(PackHeader) == 32, "PackHeader layout changed");
+static_assert(sizeof(PackSprite) == 88, "PackSprite layout changed");
+static_assert(sizeof(PackPage) == 32, "PackPage layout changed");
+
+
+#if EMBED_ASSETS
+// generated from the pack by `embedgen` (32 bit words keep it aligned)
+extern const uint32_t EMBEDDED_PACK[];
+extern const size_t EMBEDDED_PACK_SIZE; // bytes
+#endif
+
+
+class AssetPack
+{
+public:
+    AssetPack() {}
+    ~AssetPack() { this->close(); }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // map `path` and validate every table / page against the file size;
+    // false (and logged) if it is missing or malformed
+    bool open(const char *path);
+    // the pack compiled into the executable; false unless `EMBED_ASSETS`
+    bool openEmbedded();
+    void close();
+
+    bool isOpen() const { return this->mData != nullptr; }
+
+    int spriteCount() const { return this->mHeader ? this->mHeader->spriteCount : 0; }
+    int pageCount() const { return this->mHeader ? this->mHeader->pageCount : 0; }
+
+    const PackSprite& sprite(int i) const { return this->mSprites[i]; }
+    const PackPage& page(int i) const { return this->mPages[i]; }
+    // `page(i).size` bytes of pixels, valid until `close()`
+    const uint8_t *pixels(int i) const { return this->mData + this->mPages[i].offset; }
+
+private:
+    // `data` holds a whole pack (`name` is for logging)
+    bool attach(const uint8_t *data, size_t size, const char *name);
+
+    const uint8_t *mData = nullptr;
+    size_t mSize = 0;
+    bool mMapped = false;       // `mData` is ours to `munmap()`
+
+    const PackHeader *mHeader = nullptr;
+    const PackSprite *mSprites = nullptr;
+    const PackPage *mPages = nullptr;
+};
@@ -0,0 +1,370 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Audio.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <chrono>
+
+#include "core/Audio.hpp"
+#include "core/Profiler.hpp"
+
+
+// in `SoundId` order
+const char *AudioEngine::SOUND_NAMES[SOUND_COUNT] = {
+    "die",
+    "hit",
+    "point",
+    "swoosh",
+    "wing",
+};
+
+
+/**
+ * Loading
+ * -------
+ */
+static inline uint32_t read_u32(const uint8_t *p)
+{ return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static inline uint16_t read_u16(const uint8_t *p)
+{ return (uint16_t)(p[0] | (p[1] << 8)); }
+
+bool AudioEngine::loadWav(const char *path, AudioClip& clip)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in)
+    {
+        printlog(2, "audio: can't open '%s'", path);
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buf[1 << 14];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+        bytes.insert(bytes.end(), buf, buf + n);
+    fclose(in);
+
+    if (bytes.size() < 12 || memcmp(&bytes[0], "RIFF", 4) != 0 || memcmp(&bytes[8], "WAVE", 4) != 0)
+    {
+        printlog(2, "audio: '%s' isn't a WAV file", path);
+        return false;
+    }
+
+    // walk the chunks for "fmt " and "data"
+    int format = 0, channels = 0, sampleRate = 0, bits = 0;
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+    for (size_t pos = 12; pos + 8 <= bytes.size(); )
+    {
+        const uint8_t *chunk = &bytes[pos];
+        size_t size = std::min<size_t>(read_u32(chunk + 4), bytes.size() - pos - 8);
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+        {
+            format = read_u16(chunk + 8);
+            channels = read_u16(chunk + 10);
+            sampleRate = read_u32(chunk + 12);
+            bits = read_u16(chunk + 22);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            data = chunk + 8;
+            dataSize = size;
+        }
+        pos += 8 + size + (size & 1); // chunks are word aligned
+    }
+
+    if (format != 1 || (channels != 1 && channels != 2) || (bits != 8 && bits != 16) ||
+        sampleRate <= 0 || !data)
+    {
+        printlog(2, "audio: '%s': only 8 / 16 bit PCM, mono / stereo is supported", path);
+        return false;
+    }
+
+    // source frames as int16 stereo
+    int bytesPerFrame = channels * bits / 8;
+    int srcFrames = (int)(dataSize / bytesPerFrame);
+    auto sample = [&](int frame, int channel) -> int
+    {
+        const uint8_t *p = data + (size_t)frame * bytesPerFrame + (channel % channels) * (bits / 8);
+        return bits == 8 ? ((int)p[0] - 128) << 8 : (int16_t)read_u16(p);
+    };
+
+    // resample to `AUDIO_SAMPLE_RATE` (linear; the shipped clips already are)
+    double step = (double)sampleRate / AUDIO_SAMPLE_RATE;
+    int frames = (int)(srcFrames / step);
+    clip.samples.resize((size_t)frames * 2);
+    for (int i = 0; i < frames; i++)
+    {
+        double t = i * step;
+        int f = (int)t;
+        float frac = (float)(t - f);
+        int g = std::min(f + 1, srcFrames - 1);
+        for (int c = 0; c < 2; c++)
+            clip.samples[i * 2 + c] = (int16_t)Math::lerp(frac, sample(f, c), sample(g, c));
+    }
+
+    return true;
+}
+
+bool AudioEngine::load(const char *dir)
+{
+    PROFILE_SCOPE("load audio");
+
+    bool ok = true;
+    for (int i = 0; i < SOUND_COUNT; i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s.wav", dir, SOUND_NAMES[i]);
+        this->mClips[i].samples.clear();
+        ok = AudioEngine::loadWav(path, this->mClips[i]) && ok;
+    }
+    return ok;
+}
+
+
+/**
+ * Device / mixer thread
+ * ---------------------
+ */
+bool AudioEngine::start(AudioDevice *device)
+{
+    this->stop();
+
+    int periodFrames = AUDIO_PERIOD_FRAMES;
+    if (!device->open(AUDIO_SAMPLE_RATE, periodFrames))
+    {
+        printlog(2, "audio: can't open the device");
+        return false;
+    }
+    if (periodFrames <= 0 || periodFrames > AUDIO_MAX_PERIOD_FRAMES)
+    {
+        printlog(2, "audio: unsupported period of %i frames", periodFrames);
+        device->close();
+        return false;
+    }
+    this->mDevice = device;
+    this->mPeriodFrames = periodFrames;
+
+    this->mRunning.store(true);
+#if defined(AUDIO_THREAD)
+    this->mMixer = std::thread(&AudioEngine::mixerMain, this);
+#endif
+    return true;
+}
+
+void AudioEngine::stop()
+{
+    if (!this->mDevice)
+        return;
+
+    this->mRunning.store(false);
+#if defined(AUDIO_THREAD)
+    this->mMixer.join();
+#endif
+    this->mDevice->close();
+    this->mDevice = nullptr;
+}
+
+bool AudioEngine::pumpOnce()
+{
+    if (this->mDevice->available() < this->mPeriodFrames)
+        return false;
+
+    this->render(this->mOut, this->mPeriodFrames);
+
+    // what's started this period is heard once the device has played what
+    // it still has queued
+    int count = this->mStartedCount;
+    if (count > 0)
+    {
+        int64_t heardUs = AudioEngine::nowUs() +
+            (int64_t)this->mDevice->queuedFrames() * 1000000 / AUDIO_SAMPLE_RATE;
+        int latency = (int)(heardUs - this->mStartedFirstUs);
+        this->mOutputLatencyCount.fetch_add(count, std::memory_order_relaxed);
+        this->mOutputLatencySumUs.fetch_add(heardUs * count - this->mStartedSumUs, std::memory_order_relaxed);
+        if (latency > this->mOutputLatencyMaxUs.load(std::memory_order_relaxed))
+            this->mOutputLatencyMaxUs.store(latency, std::memory_order_relaxed);
+    }
+
+    this->mDevice->write(this->mOut, this->mPeriodFrames);
+    return true;
+}
+
+void AudioEngine::pump()
+{
+#if !defined(AUDIO_THREAD)
+    if (!this->mDevice)
+        return;
+    PROFILE_SCOPE("audio");
+    while (this->pumpOnce())
+        ;
+#endif
+}
+
+#if defined(AUDIO_THREAD)
+void AudioEngine::mixerMain()
+{
+    Profiler::nameThread("audio");
+
+    // poll a few times per period, at least every ms: how late a period
+    // goes out after the device has room adds straight to the latency
+    int64_t periodUs = (int64_t)this->mPeriodFrames * 1000000 / AUDIO_SAMPLE_RATE;
+    auto nap = std::chrono::microseconds(std::min<int64_t>(periodUs / 4, 1000));
+    while (this->mRunning.load(std::memory_order_relaxed))
+    {
+        if (!this->pumpOnce())
+            std::this_thread::sleep_for(nap);
+    }
+}
+#endif
+
+
+/**
+ * Playback
+ * --------
+ */
+int64_t AudioEngine::nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool AudioEngine::play(SoundId id, float gain, float delay)
+{
+    Command command;
+    command.sound = id;
+    command.gain = gain;
+    command.delayFrames = (int)(delay * AUDIO_SAMPLE_RATE);
+    command.pushedUs = AudioEngine::nowUs();
+
+    if (!this->mQueue.push(command))
+    {
+        this->mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::playTick(const GameState& prev, const GameState& next, bool flap)
+{
+    bool wasRunning = (prev.running == RunningT::Running);
+    bool isRunning = (next.running == RunningT::Running);
+
+    if (wasRunning && flap)
+        this->play(SoundId::Wing);
+    if (next.score > prev.score && next.seed == prev.seed)
+        this->play(SoundId::Point);
+
+    if (wasRunning && !isRunning)
+    {
+        this->play(SoundId::Hit);
+        // hit a pipe: the bird still has to fall
+        if (next.birdY < floorY - birdSize)
+            this->play(SoundId::Die, 1, 0.3f);
+    }
+    else if (!wasRunning && isRunning)
+        this->play(SoundId::Swoosh);
+}
+
+void AudioEngine::startVoice(const Command& command)
+{
+    const AudioClip& clip = this->mClips[(int)command.sound];
+    if (clip.frames() == 0)
+        return;
+
+    // a free voice, else cut off the one closest to its end
+    Voice *voice = nullptr;
+    for (auto& v : this->mVoices)
+    {
+        if (!v.clip)
+        {
+            voice = &v;
+            break;
+        }
+        if (!voice || v.clip->frames() - v.position < voice->clip->frames() - voice->position)
+            voice = &v;
+    }
+    if (voice->clip)
+        this->mStolen.fetch_add(1, std::memory_order_relaxed);
+
+    voice->clip = &clip;
+    voice->position = -command.delayFrames;
+    voice->gain = command.gain;
+}
+
+void AudioEngine::render(int16_t *out, int frames)
+{
+    this->mStartedCount = 0;
+    this->mStartedSumUs = 0;
+
+    while (frames > 0)
+    {
+        int count = std::min(frames, AUDIO_MAX_PERIOD_FRAMES);
+
+        // new sounds start at the top of the period
+        Command command;
+        int64_t now = AudioEngine::nowUs();
+        while (this->mQueue.pop(command))
+        {
+            int latency = (int)(now - command.pushedUs);
+            this->mPlayed.fetch_add(1, std::memory_order_relaxed);
+            this->mQueueLatencySumUs.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > this->mQueueLatencyMaxUs.load(std::memory_order_relaxed))
+                this->mQueueLatencyMaxUs.store(latency, std::memory_order_relaxed);
+            this->startVoice(command);
+
+            if (this->mStartedCount++ == 0)
+                this->mStartedFirstUs = command.pushedUs;
+            this->mStartedSumUs += command.pushedUs;
+        }
+
+        float *mix = this->mMix;
+        memset(mix, 0, sizeof(float) * count * 2);
+
+        for (auto& voice : this->mVoices)
+        {
+            if (!voice.clip)
+                continue;
+
+            int i = 0;
+            if (voice.position < 0)
+            {
+                i = std::min(-voice.position, count);
+                voice.position += i;
+            }
+
+            int n = std::min(count - i, voice.clip->frames() - voice.position);
+            if (n <= 0)
+                continue;
+            const int16_t *src = voice.clip->samples.data() + (size_t)voice.position * 2;
+            float *dst = mix + i * 2;
+            float gain = voice.gain * AUDIO_MASTER_GAIN;
+            for (int k = 0; k < n * 2; k++)
+                dst[k] += src[k] * gain;
+
+            voice.position += n;
+            if (voice.position >= voice.clip->frames())
+                voice.clip = nullptr;
+        }
+
+        // linear up to the knee, then bends towards the ceiling (tanh
+        // tops out at 1, so no clamp)
+        const float knee = AUDIO_LIMIT_KNEE * 32767;
+        const float room = (AUDIO_LIMIT_CEILING - AUDIO_LIMIT_KNEE) * 32767;
+        for (int k = 0; k < count * 2; k++)
+        {
+            float x = mix[k];
+            float a = fabsf(x);
+            if (a > knee)
+            {
+                a = knee + room * tanhf((a - knee) / room);
+                x = x < 0 ? -a : a;
+            }
+            out[k] = (int16_t)x;
+        }
+
+        out += count * 2;
+        frames -= count;
+    }
+}
@@ -0,0 +1,199 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Audio.hpp
+ * - sound effects: every clip is decoded to int16 stereo PCM once at load
+ *   time, a mixer thread mixes the playing voices a period at a time and
+ *   hands them to an `AudioDevice`
+ * - `play()` only pushes a command onto a wait-free SPSC queue (see
+ *   `SpscQueue`), so the thread triggering sounds (the sim) never waits on
+ *   the mixer or the device; voices are owned by the mixer alone
+ * - the web build has no threads: `pump()` mixes on the caller's thread
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+#include "core/SpscQueue.hpp"
+#include "core/AudioDevice.hpp"
+
+
+#if !defined(PLATFORM_WEB)
+    #define AUDIO_THREAD
+#endif
+
+#define AUDIO_DIR "resources/flappy_assets/audio"
+#define AUDIO_SAMPLE_RATE 44100
+// frames mixed at a time (~12 ms) unless the device needs another size
+#define AUDIO_PERIOD_FRAMES 512
+#define AUDIO_MAX_PERIOD_FRAMES 4096
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_QUEUE_SIZE 64
+
+// headroom (of full scale): every voice is scaled by `AUDIO_MASTER_GAIN`,
+// and the mix is soft-limited above `AUDIO_LIMIT_KNEE` so it never goes past
+// `AUDIO_LIMIT_CEILING`; stacked sounds get squashed instead of clipping
+#define AUDIO_MASTER_GAIN 0.7f
+#define AUDIO_LIMIT_KNEE 0.7f
+#define AUDIO_LIMIT_CEILING 0.95f
+
+
+// one per file in `AUDIO_DIR` (see `SOUND_NAMES`)
+enum class SoundId
+{
+    Die,
+    Hit,
+    Point,
+    Swoosh,
+    Wing,
+    Count,
+};
+#define SOUND_COUNT ((int)SoundId::Count)
+
+
+struct AudioClip
+{
+    std::vector<int16_t> samples;   // interleaved stereo, `AUDIO_SAMPLE_RATE`
+
+    int frames() const { return (int)this->samples.size() / 2; }
+};
+
+
+class AudioEngine
+{
+public:
+    AudioEngine() : mRunning(false), mPlayed(0), mDropped(0), mStolen(0),
+        mQueueLatencyMaxUs(0), mQueueLatencySumUs(0),
+        mOutputLatencyMaxUs(0), mOutputLatencySumUs(0), mOutputLatencyCount(0)
+    {}
+
+    virtual ~AudioEngine() { this->stop(); }
+
+    AudioEngine(const AudioEngine&) = delete;
+    AudioEngine& operator=(const AudioEngine&) = delete;
+
+    // file name (without extension) of each `SoundId`
+    static const char *SOUND_NAMES[SOUND_COUNT];
+
+    // 8 / 16 bit PCM WAV, mono or stereo, any rate -> `clip`
+    static bool loadWav(const char *path, AudioClip& clip);
+
+    // decode every sound in `dir` (any thread, before `start()`); sounds
+    // that fail to load stay silent
+    bool load(const char *dir);
+
+    const AudioClip& clip(SoundId id) const
+    { return this->mClips[(int)id]; }
+
+    // open `device` and start mixing into it (on the mixer thread with
+    // `AUDIO_THREAD`)
+    bool start(AudioDevice *device);
+    void stop();
+
+    /**
+     * producer side (one thread, e.g. the sim)
+     */
+    // play `id` at `gain` after `delay` seconds; wait-free, false (and
+    // counted as dropped) when the queue is full, e.g. nothing mixes
+    bool play(SoundId id, float gain = 1, float delay = 0);
+
+    // the sounds one sim tick from `prev` to `next` makes (`flap` is the
+    // tick's input)
+    void playTick(const GameState& prev, const GameState& next, bool flap);
+
+    /**
+     * consumer side
+     */
+    // without `AUDIO_THREAD`: mix whatever the device has room for now
+    // (call once a frame)
+    void pump();
+
+    // mix the next `frames` frames into `out` (interleaved stereo, peaks at
+    // most `AUDIO_LIMIT_CEILING`); what the mixer thread does, exposed for
+    // offline rendering without `start()`
+    void render(int16_t *out, int frames);
+
+    /**
+     * stats
+     */
+    int played() const { return this->mPlayed.load(std::memory_order_relaxed); }
+    int dropped() const { return this->mDropped.load(std::memory_order_relaxed); }
+    // voices cut off for a new one (all `AUDIO_MAX_VOICES` busy)
+    int stolen() const { return this->mStolen.load(std::memory_order_relaxed); }
+    // `play()` -> picked up by the mixer (us)
+    int queueLatencyMaxUs() const { return this->mQueueLatencyMaxUs.load(std::memory_order_relaxed); }
+    double queueLatencyAvgUs() const
+    {
+        int played = this->played();
+        return played > 0 ? (double)this->mQueueLatencySumUs.load(std::memory_order_relaxed) / played : 0;
+    }
+    // `play()` -> its first frame comes out of the device (us), i.e. also
+    // the wait for the next period and what the device still had queued
+    // (see `AudioDevice::queuedFrames()`); only sounds mixed after `start()`
+    int outputLatencyMaxUs() const { return this->mOutputLatencyMaxUs.load(std::memory_order_relaxed); }
+    double outputLatencyAvgUs() const
+    {
+        int count = this->mOutputLatencyCount.load(std::memory_order_relaxed);
+        return count > 0 ? (double)this->mOutputLatencySumUs.load(std::memory_order_relaxed) / count : 0;
+    }
+    int periodFrames() const { return this->mPeriodFrames; }
+
+private:
+    struct Command
+    {
+        SoundId sound;
+        float gain;
+        int delayFrames;
+        int64_t pushedUs;   // for the latency stats
+    };
+
+    struct Voice
+    {
+        const AudioClip *clip;  // nullptr = free
+        int position;           // next frame; negative while delayed
+        float gain;
+    };
+
+    static int64_t nowUs();
+
+    void startVoice(const Command& command);
+    // one period into the device, false if it has no room
+    bool pumpOnce();
+#if defined(AUDIO_THREAD)
+    void mixerMain();
+#endif
+
+    AudioClip mClips[SOUND_COUNT];
+
+    AudioDevice *mDevice = nullptr;
+    int mPeriodFrames = AUDIO_PERIOD_FRAMES;
+    std::atomic<bool> mRunning;
+#if defined(AUDIO_THREAD)
+    std::thread mMixer;
+#endif
+
+    SpscQueue<Command, AUDIO_QUEUE_SIZE> mQueue;
+
+    // mixer only
+    Voice mVoices[AUDIO_MAX_VOICES] = {};
+    // sounds the last `render()` started: how many, when they were pushed
+    int mStartedCount = 0;
+    int64_t mStartedFirstUs = 0;
+    int64_t mStartedSumUs = 0;
+    float mMix[AUDIO_MAX_PERIOD_FRAMES * 2];
+    int16_t mOut[AUDIO_MAX_PERIOD_FRAMES * 2];
+
+    std::atomic<int> mPlayed;
+    std::atomic<int> mDropped;
+    std::atomic<int> mStolen;
+    std::atomic<int> mQueueLatencyMaxUs;
+    std::atomic<int64_t> mQueueLatencySumUs;
+    std::atomic<int> mOutputLatencyMaxUs;
+    std::atomic<int64_t> mOutputLatencySumUs;
+    std::atomic<int> mOutputLatencyCount;
+};
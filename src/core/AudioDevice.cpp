@@ -0,0 +1,139 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AudioDevice.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+
+#include "core/AudioDevice.hpp"
+
+
+/**
+ * NullAudioDevice
+ * ---------------
+ */
+bool NullAudioDevice::open(int sampleRate, int& periodFrames)
+{
+    if (this->mForcedPeriod > 0)
+        periodFrames = this->mForcedPeriod;
+    this->mStart = std::chrono::steady_clock::now();
+    this->mSampleRate = sampleRate;
+    this->mBufferFrames = 2 * periodFrames;
+    this->mWritten = 0;
+    return true;
+}
+
+int64_t NullAudioDevice::played() const
+{
+    using namespace std::chrono;
+    double elapsed = duration<double>(steady_clock::now() - this->mStart).count();
+    return (int64_t)(elapsed * this->mSampleRate);
+}
+
+int NullAudioDevice::available()
+{
+    int64_t room = this->played() + this->mBufferFrames - this->mWritten;
+    return (int)std::min<int64_t>(std::max<int64_t>(room, 0), this->mBufferFrames);
+}
+
+int NullAudioDevice::queuedFrames()
+{
+    // an underrun played silence, it doesn't make later frames any later
+    int64_t queued = this->mWritten - this->played();
+    return (int)std::min<int64_t>(std::max<int64_t>(queued, 0), this->mBufferFrames);
+}
+
+void NullAudioDevice::write(const int16_t *samples, int frames)
+{
+    this->mWritten += frames;
+}
+
+
+/**
+ * WavAudioDevice
+ * --------------
+ */
+static bool write_u32(FILE *out, uint32_t value)
+{
+    uint8_t bytes[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+    return fwrite(bytes, 1, 4, out) == 4;
+}
+
+static bool write_u16(FILE *out, uint16_t value)
+{
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    return fwrite(bytes, 1, 2, out) == 2;
+}
+
+// canonical 44 byte header of a 16 bit stereo PCM file
+static bool write_wav_header(FILE *out, int sampleRate, uint32_t dataBytes)
+{
+    const int channels = 2, bytesPerFrame = 4;
+    bool ok = fwrite("RIFF", 1, 4, out) == 4;
+    ok = ok && write_u32(out, 36 + dataBytes);
+    ok = ok && fwrite("WAVEfmt ", 1, 8, out) == 8;
+    ok = ok && write_u32(out, 16);
+    ok = ok && write_u16(out, 1); // PCM
+    ok = ok && write_u16(out, channels);
+    ok = ok && write_u32(out, sampleRate);
+    ok = ok && write_u32(out, sampleRate * bytesPerFrame);
+    ok = ok && write_u16(out, bytesPerFrame);
+    ok = ok && write_u16(out, 16);
+    ok = ok && fwrite("data", 1, 4, out) == 4;
+    ok = ok && write_u32(out, dataBytes);
+    return ok;
+}
+
+bool WavAudioDevice::open(int sampleRate, int& periodFrames)
+{
+    this->close();
+
+    this->mFile = fopen(this->mPath, "wb");
+    if (!this->mFile || !write_wav_header(this->mFile, sampleRate, 0))
+    {
+        printlog(2, "can't write '%s'", this->mPath);
+        this->close();
+        return false;
+    }
+    this->mSampleRate = sampleRate;
+    this->mPeriodFrames = periodFrames;
+    this->mDataBytes = 0;
+    return NullAudioDevice::open(sampleRate, periodFrames);
+}
+
+int WavAudioDevice::available()
+{
+    if (!this->mFile)
+        return 0;
+    return this->mRealtime ? NullAudioDevice::available() : this->mPeriodFrames;
+}
+
+int WavAudioDevice::queuedFrames()
+{
+    return this->mRealtime ? NullAudioDevice::queuedFrames() : 0;
+}
+
+void WavAudioDevice::write(const int16_t *samples, int frames)
+{
+    if (!this->mFile)
+        return;
+
+    // NOTE: WAV is little endian, like every platform we build for
+    this->mDataBytes += (uint32_t)fwrite(samples, 4, frames, this->mFile) * 4;
+    NullAudioDevice::write(samples, frames);
+}
+
+void WavAudioDevice::close()
+{
+    if (!this->mFile)
+        return;
+
+    bool ok = fseek(this->mFile, 0, SEEK_SET) == 0 &&
+        write_wav_header(this->mFile, this->mSampleRate, this->mDataBytes);
+    ok = (fclose(this->mFile) == 0) && ok;
+    if (!ok)
+        printlog(2, "can't write '%s'", this->mPath);
+    this->mFile = nullptr;
+}
@@ -0,0 +1,99 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AudioDevice.hpp
+ * - where `AudioEngine`'s mixer thread sends its output: int16 stereo frames,
+ *   one period at a time, whenever the device has room for them
+ * - `NullAudioDevice` plays into nothing at real-time speed,
+ *   `WavAudioDevice` records to a file; both run without any sound hardware
+ *   (headless, CI). The game's device lives outside the core (see
+ *   `RaylibAudio.hpp`)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+#include "core/core.hpp"
+
+
+class AudioDevice
+{
+public:
+    virtual ~AudioDevice() {}
+
+    // int16 stereo at `sampleRate`; `periodFrames` is what the mixer would
+    // like to write at a time, a device may change it to what it needs
+    // (up to `AUDIO_MAX_PERIOD_FRAMES`)
+    virtual bool open(int sampleRate, int& periodFrames) = 0;
+    // frames `write()` takes right now without blocking
+    virtual int available() = 0;
+    // frames written that haven't been heard yet: how long something
+    // `write()`n now waits before it plays (the device's buffering)
+    virtual int queuedFrames() = 0;
+    virtual void write(const int16_t *samples, int frames) = 0;
+    virtual void close() = 0;
+};
+
+
+/**
+ * consumes frames at `sampleRate` by the wall clock, with two periods of
+ * buffering like a real device; `periodFrames` > 0 forces that period (to
+ * time the mixer against another device's buffer size)
+ */
+class NullAudioDevice : public AudioDevice
+{
+public:
+    NullAudioDevice(int periodFrames = 0)
+        : mForcedPeriod(periodFrames)
+    {}
+
+    bool open(int sampleRate, int& periodFrames) override;
+    int available() override;
+    int queuedFrames() override;
+    void write(const int16_t *samples, int frames) override;
+    void close() override {}
+
+    int64_t framesWritten() const { return this->mWritten; }
+
+private:
+    // frames played by the wall clock
+    int64_t played() const;
+
+    std::chrono::steady_clock::time_point mStart;
+    int mForcedPeriod;
+    int mSampleRate = 0;
+    int mBufferFrames = 0;
+    int64_t mWritten = 0;
+};
+
+
+/**
+ * `NullAudioDevice` that also records everything to a 16 bit stereo WAV;
+ * unless `realtime`, it always has room for another period, so a mixer can
+ * render into it as fast as it likes (offline rendering)
+ */
+class WavAudioDevice : public NullAudioDevice
+{
+public:
+    WavAudioDevice(const char *path, bool realtime = true)
+        : mPath(path), mRealtime(realtime)
+    {}
+
+    virtual ~WavAudioDevice() { this->close(); }
+
+    bool open(int sampleRate, int& periodFrames) override;
+    int available() override;
+    int queuedFrames() override;
+    void write(const int16_t *samples, int frames) override;
+    // patches the sizes into the header
+    void close() override;
+
+private:
+    const char *mPath;
+    bool mRealtime;
+    FILE *mFile = nullptr;
+    int mSampleRate = 0;
+    int mPeriodFrames = 0;
+    uint32_t mDataBytes = 0;
+};
@@ -0,0 +1,313 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Batch.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "core/Batch.hpp"
+#include "util/Simd.hpp"
+#include "util/Collision.hpp"
+
+
+/**
+ * BatchedGameState
+ * ----------------
+ */
+BatchedGameState::BatchedGameState(int size, uint64_t seed, int numPipes)
+{
+    assert(size > 0);
+
+    // whole cache lines per column keep every column 64-byte aligned (and
+    // cover whole SIMD vectors)
+    const int lineFloats = CACHE_LINE / (int)sizeof(float);
+    static_assert(lineFloats % simd::LANES == 0, "columns must hold whole vectors");
+    this->size = size;
+    this->numPipes = GameState(seed, numPipes).numPipes; // same clamping
+    this->capacity = (size + lineFloats - 1) / lineFloats * lineFloats;
+
+    const int numColumns = 11 + BATCH_PIPES * 2;
+    size_t columnBytes = this->capacity * sizeof(float);
+    size_t seedBytes = this->capacity * sizeof(uint64_t);
+    size_t totalBytes = seedBytes + columnBytes * numColumns + this->capacity;
+
+    if (posix_memalign(&this->mStorage, 64, totalBytes) != 0)
+        die("BatchedGameState: alloc failed");
+    memset(this->mStorage, 0, totalBytes);
+
+    char *ptr = (char *)this->mStorage;
+    auto next = [&]() { char *col = ptr; ptr += columnBytes; return col; };
+
+    this->seed = (uint64_t *)ptr;
+    ptr += seedBytes;
+
+    this->birdY = (float *)next();
+    this->birdVY = (float *)next();
+    this->xOffset = (float *)next();
+    this->score = (int32_t *)next();
+    this->running = (int32_t *)next();
+    this->episodeScore = (int32_t *)next();
+    this->pipeHead = (int32_t *)next();
+    this->anchorTicks = (int32_t *)next();
+    this->anchorX = (float *)next();
+    this->anchorY = (float *)next();
+    this->anchorVY = (float *)next();
+    for (int p = 0; p < BATCH_PIPES; p++)
+    {
+        this->pipeX[p] = (float *)next();
+        this->pipeY[p] = (float *)next();
+    }
+    this->done = (uint8_t *)ptr;
+
+    // padding lanes are stepped too (results ignored), so keep them valid
+    for (int i = 0; i < this->capacity; i++)
+        this->reset(i, seed + i);
+}
+
+BatchedGameState::~BatchedGameState()
+{
+    free(this->mStorage);
+}
+
+void BatchedGameState::reset(int i, uint64_t seed)
+{
+    this->birdY[i] = defaultBirdY;
+    this->birdVY[i] = 0;
+    this->xOffset[i] = 0;
+    this->score[i] = 0;
+    this->running[i] = (int32_t)RunningT::Running;
+    this->anchorTicks[i] = 0;
+    this->anchorX[i] = 0;
+    this->anchorY[i] = defaultBirdY;
+    this->anchorVY[i] = 0;
+
+    this->seed[i] = seed;
+    this->pipeHead[i] = 0;
+
+    for (int p = 0; p < BATCH_PIPES; p++)
+    {
+        this->pipeX[p][i] = Level::pipeX(seed, p);
+        this->pipeY[p][i] = Level::pipeY(seed, p);
+    }
+}
+
+void BatchedGameState::load(int i, const GameState& gameState)
+{
+    assert(gameState.numPipes == this->numPipes);
+
+    this->birdY[i] = gameState.birdY;
+    this->birdVY[i] = gameState.birdVY;
+    this->xOffset[i] = gameState.xOffset;
+    this->score[i] = gameState.score;
+    this->running[i] = (int32_t)gameState.running;
+    this->anchorTicks[i] = gameState.anchorTicks;
+    this->anchorX[i] = gameState.anchorX;
+    this->anchorY[i] = gameState.anchorY;
+    this->anchorVY[i] = gameState.anchorVY;
+    this->seed[i] = gameState.seed;
+    this->pipeHead[i] = gameState.pipeHead;
+    for (int p = 0; p < BATCH_PIPES; p++)
+    {
+        auto& pipe = gameState.pipe(gameState.pipeHead + p);
+        this->pipeX[p][i] = pipe.x;
+        this->pipeY[p][i] = pipe.y;
+    }
+}
+
+void BatchedGameState::store(int i, GameState& gameState) const
+{
+    gameState.birdY = this->birdY[i];
+    gameState.birdVY = this->birdVY[i];
+    gameState.xOffset = this->xOffset[i];
+    gameState.score = this->score[i];
+    gameState.running = (RunningT)this->running[i];
+    gameState.anchorTicks = this->anchorTicks[i];
+    gameState.anchorX = this->anchorX[i];
+    gameState.anchorY = this->anchorY[i];
+    gameState.anchorVY = this->anchorVY[i];
+    gameState.seed = this->seed[i];
+    gameState.numPipes = this->numPipes;
+    gameState.pipeHead = this->pipeHead[i];
+    gameState.nextPipe = gameState.pipeHead + this->numPipes;
+    for (int k = gameState.pipeHead; k < gameState.nextPipe; k++)
+        gameState.pipe(k) = Level::pipe(gameState.seed, k);
+}
+
+
+
+/**
+ * BatchSim
+ * --------
+ */
+
+// scalar slow path: same pipe recycling as `Sim::step()`; only runs for the
+// (rare) lanes where the head pipe has left the screen
+static void recycle_pipes(BatchedGameState& b, int i)
+{
+    int head = ++b.pipeHead[i];
+    for (int p = 0; p < BATCH_PIPES - 1; p++)
+    {
+        b.pipeX[p][i] = b.pipeX[p + 1][i];
+        b.pipeY[p][i] = b.pipeY[p + 1][i];
+    }
+    b.pipeX[BATCH_PIPES - 1][i] = Level::pipeX(b.seed[i], head + BATCH_PIPES - 1);
+    b.pipeY[BATCH_PIPES - 1][i] = Level::pipeY(b.seed[i], head + BATCH_PIPES - 1);
+}
+
+void BatchSim::step(BatchedGameState& b, const uint8_t *flap)
+{
+    BatchSim::step(b, flap, 0, b.capacity);
+}
+
+void BatchSim::step(BatchedGameState& b, const uint8_t *flap, int begin, int end)
+{
+    using namespace simd;
+
+    assert(begin % LANES == 0);
+    assert(end % LANES == 0 && end <= b.capacity);
+
+    const vi RUNNING = splat((int32_t)RunningT::Running);
+    const vi DEAD = splat((int32_t)RunningT::Dead);
+    const vi RESTART = splat((int32_t)RunningT::Restart);
+
+    const vf vTickTime = splat(tickTime);
+    const vf vGravityV = splat(gravity * tickTime);
+    const vf vGravityY = splat(gravity * tickTime * tickTime);
+    const vf vScroll = splat(speed * tickTime);
+    const vf vJump = splat(jumpForce);
+    const vf vCeil = splat(birdSize);
+    const vf vFloor = splat(floorY - birdSize);
+    const vf vBirdX = splat(birdX);
+    const vf vBirdSize = splat(birdSize);
+    const vf vPipeW = splat(pipeWidth);
+    const vf vHalfGap = splat(halfGap);
+    const vf vFloorY = splat(floorY);
+    const vf vZero = splat(0.0f);
+
+    for (int i = begin; i < end; i += LANES)
+    {
+        vi state = load(&b.running[i]);
+        vi isRunning = state == RUNNING;
+        vi isDead = state == DEAD;
+        vi isRestart = state == RESTART;
+
+        vi flapMask = splat(0);
+        for (int l = 0; l < LANES && i + l < b.size; l++)
+            flapMask[l] = flap[i + l] ? -1 : 0;
+
+        vf y = load(&b.birdY[i]);
+        vf vy = load(&b.birdVY[i]);
+        vf xOff = load(&b.xOffset[i]);
+
+        vi m = load(&b.anchorTicks[i]);
+        vf aX = load(&b.anchorX[i]);
+        vf aY = load(&b.anchorY[i]);
+        vf aVY = load(&b.anchorVY[i]);
+
+        // restart the closed form from the current state (see `Sim::step()`)
+        auto reanchor = [&](vi mask)
+        {
+            m = select(mask, splat(0), m);
+            aX = select(mask, xOff, aX);
+            aY = select(mask, y, aY);
+            aVY = select(mask, vy, aVY);
+        };
+
+        /**
+         * jump (running only)
+         */
+        vi jump = isRunning & flapMask;
+        vy = select(jump, vJump, vy);
+        reanchor(jump);
+
+        /**
+         * scroll (running) + bird physics (running + dead), closed form
+         */
+        vi falling = isRunning | isDead;
+        m = select(falling, m + splat(1), m);
+
+        vf mf = tofloat(m);
+        vf tri = tofloat((m * (m + splat(1))) >> 1);
+        vf newX = aX + mf * vScroll;
+        vf newVY = aVY + mf * vGravityV;
+        vf newY = aY + mf * (aVY * vTickTime) + tri * vGravityY;
+
+        xOff = select(isRunning, newX, xOff);
+        vy = select(falling, newVY, vy);
+        y = select(falling, clamp(newY, vCeil, vFloor), y);
+
+        // stuck at the ceiling: the parabola continues from there
+        reanchor(falling & (newY < vCeil));
+
+        store(&b.xOffset[i], xOff);
+
+        /**
+         * recycle pipes (scalar fixup for the lanes that need it)
+         */
+        vi needsRecycle = isRunning & ((load(&b.pipeX[0][i]) - xOff + vPipeW) <= vZero);
+
+        if (any(needsRecycle))
+        {
+            uint32_t laneBits = bits(needsRecycle);
+            for (int l = 0; l < LANES; l++)
+                if (laneBits & (1u << l))
+                    recycle_pipes(b, i + l);
+        }
+
+        /**
+         * collisions + score
+         */
+        vi hitPipe = splat(0);
+        vi scored = splat(0);
+        vf birdWorldX = vBirdX + xOff;
+        for (int p = 0; p < BATCH_PIPES; p++)
+        {
+            vf px = load(&b.pipeX[p][i]);
+            vf py = load(&b.pipeY[p][i]);
+            vf xPos = px - xOff;
+
+            hitPipe |= Collision::circleRect(vBirdX, y, vBirdSize, xPos, vZero, vPipeW, py - vHalfGap);
+            hitPipe |= Collision::circleRect(vBirdX, y, vBirdSize, xPos, py + vHalfGap, vPipeW, vFloorY);
+
+            // each passed pipe adds 1 (mask lanes are -1)
+            scored -= isRunning & (birdWorldX <= px) & ((birdWorldX + vScroll) > px);
+        }
+        vi hitFloor = y >= vFloor;
+
+        vi died = isRunning & (hitPipe | hitFloor);
+        vy = select(died & hitPipe, vJump, vy);
+        reanchor(died);
+        state = select(died, DEAD, state);
+        state = select(isDead & hitFloor, RESTART, state);
+
+        vi score = load(&b.score[i]) + scored;
+
+        store(&b.birdY[i], y);
+        store(&b.birdVY[i], vy);
+        store(&b.score[i], score);
+        store(&b.running[i], state);
+        store(&b.anchorTicks[i], m);
+        store(&b.anchorX[i], aX);
+        store(&b.anchorY[i], aY);
+        store(&b.anchorVY[i], aVY);
+
+        /**
+         * finished episodes + restarts (scalar fixup)
+         */
+        uint32_t diedBits = bits(died);
+        uint32_t restartBits = bits(isRestart & flapMask);
+        for (int l = 0; l < LANES; l++)
+        {
+            uint32_t bit = 1u << l;
+            b.done[i + l] = (diedBits & bit) ? 1 : 0;
+            if (diedBits & bit)
+            {
+                b.episodeScore[i + l] = b.score[i + l];
+                if (b.autoReset)
+                    b.reset(i + l, Level::nextSeed(b.seed[i + l]));
+            }
+            else if (restartBits & bit)
+            {
+                b.reset(i + l, Level::nextSeed(b.seed[i + l]));
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Batch.hpp
+ * - structure-of-arrays storage for many independent games, stepped together
+ *   by a masked (branch-free) SIMD kernel. Same rules as `Sim::step()`.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+
+
+// pipes stored per environment: the head of the `GameState` ring and the
+// one after it, the only ones that can reach the bird (see `Sim::step()`);
+// the rest of the ring is regenerated from `Level` on `store()`
+#define BATCH_PIPES         2
+
+
+class BatchedGameState
+{
+public:
+    int size = 0;       // number of environments
+    // `size` rounded up to a cache line of floats (16): a multiple of
+    // `simd::LANES` on every target, and it keeps each column 64-byte aligned
+    int capacity = 0;
+
+    // per-environment columns (each `capacity` long, 64-byte aligned)
+    float *birdY = nullptr;
+    float *birdVY = nullptr;
+    float *xOffset = nullptr;
+    int32_t *score = nullptr;
+    int32_t *running = nullptr;         // `RunningT` as int
+    float *pipeX[BATCH_PIPES] = {};     // level pipes [pipeHead, pipeHead + BATCH_PIPES)
+    float *pipeY[BATCH_PIPES] = {};
+    uint64_t *seed = nullptr;           // level seed (see `Level`)
+    int32_t *pipeHead = nullptr;        // level index of the oldest live pipe
+    int32_t *anchorTicks = nullptr;     // closed-form motion (see `GameState`)
+    float *anchorX = nullptr;
+    float *anchorY = nullptr;
+    float *anchorVY = nullptr;
+
+    // per-tick outputs
+    uint8_t *done = nullptr;            // set on the tick a lane dies
+    int32_t *episodeScore = nullptr;    // score of the last finished episode
+
+    // reset lanes as soon as they die (instead of waiting for a restart input)
+    bool autoReset = true;
+
+    // `GameState::numPipes` of every environment (only matters to `store()`)
+    int numPipes = DEFAULT_PIPES;
+
+    // environment `i` starts with level seed `seed + i`, i.e. it plays the
+    // same game as `GameState(seed + i, numPipes)`
+    BatchedGameState(int size, uint64_t seed = rng::DEFAULT_SEED, int numPipes = DEFAULT_PIPES);
+    ~BatchedGameState();
+
+    BatchedGameState(const BatchedGameState&) = delete;
+    BatchedGameState& operator=(const BatchedGameState&) = delete;
+
+    // reset a single environment to the start of a new game
+    void reset(int i, uint64_t seed);
+
+    // copy an environment in / out of the scalar representation
+    void load(int i, const GameState& gameState);
+    void store(int i, GameState& gameState) const;
+
+private:
+    void *mStorage = nullptr;
+};
+
+
+class BatchSim
+{
+public:
+    // advance every environment by one tick; `flap` holds one byte per env
+    static void step(BatchedGameState& batch, const uint8_t *flap);
+
+    // advance environments [begin, end) only; `begin` must be a multiple of
+    // `simd::LANES` and `end` one too (or `batch.capacity`)
+    static void step(BatchedGameState& batch, const uint8_t *flap, int begin, int end);
+};
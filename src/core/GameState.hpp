@@ -0,0 +1,197 @@
+/**
+ * -----------------------------------------------------------------------------
+ * GameState.hpp
+ * - simulation state for a single game; raylib-free (see `core.hpp`)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <type_traits>
+
+#include "core/core.hpp"
+
+using namespace std;
+
+
+/**
+ * SEE: https://github.com/bsansouci/reprocessing-example/tree/livestream-flappybird 
+ */
+
+// constants
+const float jumpForce = -500.;
+const float speed = 175.;
+const float pipeWidth = 50.;
+const float halfGap = 70.; 
+const float birdSize = 15.; // 20.; // bird radius
+const float gravity = 1400.;
+const float birdX = 50.;
+const float defaultBirdY = 50.;
+// const float pipeHeight = 350.; // TODO: UNUSED; REMOVE
+const float floorY = 500.;
+// level layout: pipe `k` sits at `initialPipeX + k*pipeSpacing`, jittered by
+// up to +/- `pipeJitter`, so gaps between pipes are in [200, 300]
+const float initialPipeX = 500.;
+const float pipeSpacing = 250.;
+const float pipeJitter = 25.;
+const float pipeMinY = 50 + halfGap;
+const float pipeMaxY = floorY - 50 - halfGap;
+// seconds per sim tick; kept as `float` so every sim path rounds the same
+const float tickTime = DELTA_TIME;
+
+
+/**
+ * Level layout
+ * - every pipe is a pure function of (seed, pipe index), so any pipe can be
+ *   generated without generating the ones before it, on any thread
+ */
+class Level
+{
+public:
+    static float pipeX(uint64_t seed, int k)
+    {
+        return initialPipeX + k * pipeSpacing + rng::range(seed, 2 * k, -pipeJitter, pipeJitter);
+    }
+
+    static float pipeY(uint64_t seed, int k)
+    {
+        return rng::range(seed, 2 * k + 1, pipeMinY, pipeMaxY);
+    }
+
+    static Vec2f pipe(uint64_t seed, int k)
+    {
+        return Vec2f(pipeX(seed, k), pipeY(seed, k));
+    }
+
+    // fill pipes [firstPipe, firstPipe + count); iterations are independent
+    static void fillPipes(uint64_t seed, int firstPipe, int count, float *xs, float *ys)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] = pipeX(seed, firstPipe + i);
+            ys[i] = pipeY(seed, firstPipe + i);
+        }
+    }
+
+    // pipes needed to keep a view `viewWidth` wide filled (pipes are at
+    // least `pipeSpacing - 2*pipeJitter` apart, +1 for the one leaving)
+    static int pipesFor(float viewWidth)
+    {
+        return (int)ceilf((viewWidth + pipeWidth) / (pipeSpacing - 2 * pipeJitter)) + 1;
+    }
+
+    // seed for the game after the one played with `seed`
+    static uint64_t nextSeed(uint64_t seed)
+    {
+        return rng::mix64(seed);
+    }
+};
+
+
+
+enum class RunningT {
+    Running,
+    Dead,
+    Restart,
+};
+
+
+
+// ring capacity of `GameState::pipes` (power of two), i.e. the most pipes
+// that can be alive at once
+#define MAX_PIPES           32
+// pipes alive at once unless asked otherwise (covers `SCREEN_W`)
+#define DEFAULT_PIPES       4
+
+static_assert((MAX_PIPES & (MAX_PIPES - 1)) == 0, "MAX_PIPES must be a power of two");
+
+
+/**
+ * NOTE: must stay trivially copyable (no heap members, no virtuals, no
+ * logging) so cloning / resetting a game is a plain memcpy (see
+ * `GameSnapshot`)
+ */
+class alignas(CACHE_LINE) GameState
+{
+public:
+    RunningT running = RunningT::Running;
+    int score = 0;
+    float birdY = defaultBirdY;
+    float birdVY = 0.;
+    float xOffset = 0;
+    uint64_t seed = rng::DEFAULT_SEED;
+
+    // motion is closed form from an anchor (see `Sim::step()`): `xOffset`,
+    // `birdY`, `birdVY` are the state `anchorTicks` ticks after
+    // (`anchorX`, `anchorY`, `anchorVY`); re-anchored on flaps and deaths
+    int anchorTicks = 0;
+    float anchorX = 0;
+    float anchorY = defaultBirdY;
+    float anchorVY = 0;
+
+    // live pipes are level indices [pipeHead, nextPipe), oldest (leftmost)
+    // first; pipe `k` lives in `pipes[k % MAX_PIPES]`
+    int numPipes = DEFAULT_PIPES;
+    int pipeHead = 0;
+    int nextPipe = 0; // level index of the next pipe to spawn (ring tail)
+    Vec2f pipes[MAX_PIPES];
+
+    // constructor
+    GameState(uint64_t seed = rng::DEFAULT_SEED, int numPipes = DEFAULT_PIPES)
+    {
+        // generate pipes
+        this->seed = seed;
+        this->numPipes = numPipes < 2 ? 2 : (numPipes > MAX_PIPES ? MAX_PIPES : numPipes);
+        while (this->nextPipe < this->numPipes)
+        {
+            this->pipe(this->nextPipe) = Level::pipe(seed, this->nextPipe);
+            this->nextPipe++;
+        }
+    }
+
+    Vec2f& pipe(int k)              { return this->pipes[k & (MAX_PIPES - 1)]; }
+    const Vec2f& pipe(int k) const  { return this->pipes[k & (MAX_PIPES - 1)]; }
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be trivially copyable");
+
+// same simulation state: every sim field + the live pipes (padding and
+// stale ring slots don't count)
+inline bool operator==(const GameState& a, const GameState& b)
+{
+    bool same = (
+        a.running == b.running && a.score == b.score &&
+        a.birdY == b.birdY && a.birdVY == b.birdVY && a.xOffset == b.xOffset &&
+        a.seed == b.seed &&
+        a.anchorTicks == b.anchorTicks && a.anchorX == b.anchorX &&
+        a.anchorY == b.anchorY && a.anchorVY == b.anchorVY &&
+        a.numPipes == b.numPipes && a.pipeHead == b.pipeHead && a.nextPipe == b.nextPipe
+    );
+    for (int k = a.pipeHead; same && k < a.nextPipe; k++)
+        same = a.pipe(k).x == b.pipe(k).x && a.pipe(k).y == b.pipe(k).y;
+    return same;
+}
+
+inline bool operator!=(const GameState& a, const GameState& b)
+{
+    return !(a == b);
+}
+
+
+/**
+ * Snapshot of a `GameState` for cheap fork / clone (planners, replays):
+ * fixed size, cache-line aligned, saved / restored with a single memcpy
+ */
+struct alignas(CACHE_LINE) GameSnapshot
+{
+    unsigned char bytes[sizeof(GameState)];
+
+    void save(const GameState& gameState)
+    {
+        memcpy(this->bytes, &gameState, sizeof(GameState));
+    }
+
+    void restore(GameState& gameState) const
+    {
+        memcpy(&gameState, this->bytes, sizeof(GameState));
+    }
+};
@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------------------------------
+ * HudText.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "core/HudText.hpp"
+
+
+int Hud::scoreDigits(int score, int digits[HUD_MAX_DIGITS])
+{
+    // least significant first, then flipped
+    int len = 0;
+    int value = score > 0 ? score : 0;
+    do {
+        digits[len++] = value % 10;
+        value /= 10;
+    } while (value > 0 && len < HUD_MAX_DIGITS);
+
+    for (int i = 0; i < len / 2; i++)
+    {
+        int d = digits[i];
+        digits[i] = digits[len - 1 - i];
+        digits[len - 1 - i] = d;
+    }
+    return len;
+}
+
+
+const char *Hud::fps(HudText& out, int fps)
+{
+    snprintf(out.text, sizeof(out.text), "FPS: %i", fps);
+    return out.text;
+}
+
+const char *Hud::ticks(HudText& out, int ticks, float alpha)
+{
+    snprintf(out.text, sizeof(out.text), "Ticks: %i | a: %.2f", ticks, alpha);
+    return out.text;
+}
+
+const char *Hud::allocs(HudText& out, int frameAllocs, int simAllocs)
+{
+    snprintf(out.text, sizeof(out.text), "Allocs: %i | sim: %i", frameAllocs, simAllocs);
+    return out.text;
+}
+
+const char *Hud::sprites(HudText& out, int sprites, int culled)
+{
+    snprintf(out.text, sizeof(out.text), "Sprites: %i | culled: %i", sprites, culled);
+    return out.text;
+}
+
+const char *Hud::draws(HudText& out, int drawCalls, int vertices)
+{
+    snprintf(out.text, sizeof(out.text), "Draws: %i | Verts: %i", drawCalls, vertices);
+    return out.text;
+}
+
+const char *Hud::plan(HudText& out, int micros, bool survives)
+{
+    snprintf(out.text, sizeof(out.text), "Plan: %ius %s", micros, survives ? "" : "(doomed)");
+    return out.text;
+}
+
+const char *Hud::replayTick(HudText& out, int tick, int length)
+{
+    snprintf(out.text, sizeof(out.text), "Tick: %i / %i", tick, length);
+    return out.text;
+}
+
+const char *Hud::zoom(HudText& out, float amount)
+{
+    snprintf(out.text, sizeof(out.text), "Zoom Amount: %.2f", amount);
+    return out.text;
+}
+
+const char *Hud::profileThread(HudText& out, const char *name, int thread)
+{
+    if (name)
+        snprintf(out.text, sizeof(out.text), "[%s]", name);
+    else
+        snprintf(out.text, sizeof(out.text), "[thread %i]", thread);
+    return out.text;
+}
+
+const char *Hud::profileStat(HudText& out, int depth, const char *name, double avgMs)
+{
+    snprintf(out.text, sizeof(out.text), "%*s%s: %.2f", depth * 2, "", name, avgMs);
+    return out.text;
+}
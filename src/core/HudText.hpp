@@ -0,0 +1,47 @@
+/**
+ * -----------------------------------------------------------------------------
+ * HudText.hpp
+ * - the text the renderer puts on screen every frame: score digits and the
+ *   debug gui labels. Formatted here, without raylib, so `headless alloc`
+ *   checks the same code the window runs
+ * - every label goes into a caller-owned `HudText`, nothing allocates
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include "core/core.hpp"
+
+
+// digits of the largest score shown (`int` has at most 10)
+#define HUD_MAX_DIGITS 10
+
+
+// one formatted label, truncated to fit
+struct HudText
+{
+    char text[64];
+};
+
+
+class Hud
+{
+public:
+    // decimal digits of `score` (negative shows as 0), most significant
+    // first; returns how many
+    static int scoreDigits(int score, int digits[HUD_MAX_DIGITS]);
+
+    /**
+     * gui labels; each returns `out.text`
+     */
+    static const char *fps(HudText& out, int fps);
+    static const char *ticks(HudText& out, int ticks, float alpha);
+    static const char *allocs(HudText& out, int frameAllocs, int simAllocs);
+    static const char *sprites(HudText& out, int sprites, int culled);
+    static const char *draws(HudText& out, int drawCalls, int vertices);
+    static const char *plan(HudText& out, int micros, bool survives);
+    static const char *replayTick(HudText& out, int tick, int length);
+    static const char *zoom(HudText& out, float amount);
+    // profiler panel: "[name]" / "[thread n]" header, then indented stats
+    static const char *profileThread(HudText& out, const char *name, int thread);
+    static const char *profileStat(HudText& out, int depth, const char *name, double avgMs);
+};
@@ -0,0 +1,175 @@
+/**
+ * -----------------------------------------------------------------------------
+ * JobPool.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <new>
+
+#include "core/JobPool.hpp"
+
+
+JobPool::JobPool(int numThreads)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = (int)std::thread::hardware_concurrency();
+        numThreads = numThreads > 0 ? numThreads : 1;
+    }
+
+    this->mRemaining = 0;
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        // `Worker` is over-aligned, which plain `new` doesn't honour in C++11
+        void *mem = nullptr;
+        if (posix_memalign(&mem, CACHE_LINE, sizeof(Worker)) != 0)
+            die("JobPool: alloc failed");
+        Worker *worker = new (mem) Worker();
+        worker->stats.tasks = 0;
+        worker->stats.steals = 0;
+        worker->stats.steps = 0;
+        this->mWorkers.push_back(worker);
+    }
+
+    // worker 0 is whoever calls `run()`
+    for (int i = 1; i < numThreads; i++)
+        this->mWorkers[i]->thread = std::thread(&JobPool::workLoop, this, i);
+}
+
+JobPool::~JobPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->mWakeLock);
+        this->mQuit = true;
+    }
+    this->mWake.notify_all();
+
+    for (auto worker : this->mWorkers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+        worker->~Worker();
+        free(worker);
+    }
+}
+
+void JobPool::resetStats()
+{
+    for (auto worker : this->mWorkers)
+    {
+        worker->stats.tasks = 0;
+        worker->stats.steals = 0;
+        worker->stats.steps = 0;
+    }
+}
+
+void JobPool::reserve(int numTasks)
+{
+    int count = this->numThreads();
+    int perWorker = (numTasks + count - 1) / count;
+    for (auto worker : this->mWorkers)
+    {
+        std::lock_guard<std::mutex> guard(worker->lock);
+        if ((int)worker->tasks.size() < perWorker)
+            worker->tasks.resize(perWorker);
+    }
+}
+
+bool JobPool::popTask(int worker, Task& task)
+{
+    // own deque: LIFO from the back
+    {
+        Worker *self = this->mWorkers[worker];
+        std::lock_guard<std::mutex> guard(self->lock);
+        if (self->front < self->back)
+        {
+            task = self->tasks[--self->back];
+            return true;
+        }
+    }
+
+    // steal: FIFO from the front of the next non-empty victim
+    int count = this->numThreads();
+    for (int i = 1; i < count; i++)
+    {
+        Worker *victim = this->mWorkers[(worker + i) % count];
+        std::lock_guard<std::mutex> guard(victim->lock);
+        if (victim->front < victim->back)
+        {
+            task = victim->tasks[victim->front++];
+            this->mWorkers[worker]->stats.steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobPool::runTask(int worker, const Task& task)
+{
+    task.fn(task.ctx, task.index, worker);
+    this->mWorkers[worker]->stats.tasks.fetch_add(1, std::memory_order_relaxed);
+    this->mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobPool::runTasks(int numTasks, TaskFn fn, const void *ctx)
+{
+    if (numTasks <= 0)
+        return;
+
+    int count = this->numThreads();
+
+    // only allocates for a batch bigger than any before
+    this->reserve(numTasks);
+
+    this->mRemaining.store(numTasks, std::memory_order_release);
+
+    // deal tasks round-robin (workers from the last batch may still be
+    // scanning for work, so take the locks); every deque was drained by the
+    // last batch
+    for (int w = 0; w < count; w++)
+    {
+        Worker *worker = this->mWorkers[w];
+        std::lock_guard<std::mutex> guard(worker->lock);
+        worker->front = 0;
+        worker->back = 0;
+        for (int i = w; i < numTasks; i += count)
+            worker->tasks[worker->back++] = Task{fn, ctx, i};
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->mWakeLock);
+        this->mEpoch++;
+    }
+    this->mWake.notify_all();
+
+    // the caller works too, then waits for stragglers
+    Task task;
+    while (this->popTask(0, task))
+        this->runTask(0, task);
+
+    while (this->mRemaining.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+}
+
+void JobPool::workLoop(int worker)
+{
+    uint64_t seenEpoch = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(this->mWakeLock);
+            this->mWake.wait(guard, [&]() {
+                return this->mQuit || this->mEpoch != seenEpoch;
+            });
+            if (this->mQuit)
+                return;
+            seenEpoch = this->mEpoch;
+        }
+
+        Task task;
+        while (this->popTask(worker, task))
+            this->runTask(worker, task);
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * -----------------------------------------------------------------------------
+ * JobPool.hpp
+ * - work-stealing job scheduler: tasks are dealt round-robin into per-worker
+ *   deques; a worker pops its own deque from the back and steals from the
+ *   front of the others' once it runs dry. The calling thread is worker 0.
+ * - `run()` takes any callable by reference (no `std::function`) and the
+ *   deques are fixed arrays grown only by a batch bigger than any before,
+ *   so running a batch doesn't allocate once `reserve()`d / warm.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/core.hpp"
+
+
+class JobPool
+{
+public:
+    // `task` index in [0, numTasks), `worker` index in [0, numThreads);
+    // `ctx` is the callable given to `run()`
+    using TaskFn = void (*)(const void *ctx, int task, int worker);
+
+    // per-worker counters, padded to a cache line so workers never share one
+    struct alignas(CACHE_LINE) WorkerStats
+    {
+        std::atomic<uint64_t> tasks;
+        std::atomic<uint64_t> steals;
+        std::atomic<uint64_t> steps; // free for the caller (e.g. env-steps)
+    };
+
+    // `numThreads` <= 0 uses every hardware thread
+    JobPool(int numThreads = 0);
+    ~JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    int numThreads() const { return (int)this->mWorkers.size(); }
+
+    // run `fn(task, worker)` for every task and return once all have
+    // finished
+    template<typename Fn>
+    void run(int numTasks, const Fn& fn)
+    {
+        this->runTasks(numTasks, [](const void *ctx, int task, int worker) {
+            (*(const Fn *)ctx)(task, worker);
+        }, &fn);
+    }
+
+    // make room for batches of up to `numTasks` up front
+    void reserve(int numTasks);
+
+    WorkerStats& stats(int worker) { return this->mWorkers[worker]->stats; }
+    void resetStats();
+
+private:
+    // tasks carry their function so a worker that wakes late can never run
+    // a task of one batch with the function of another
+    struct Task
+    {
+        TaskFn fn;
+        const void *ctx;
+        int index;
+    };
+
+    struct alignas(CACHE_LINE) Worker
+    {
+        std::mutex lock;            // guards the deque (owner + thieves)
+        // deque of this batch: [`front`, `back`) of `tasks`; empty between
+        // batches, so each batch deals from the start again
+        std::vector<Task> tasks;
+        int front = 0;
+        int back = 0;
+        std::thread thread;
+        WorkerStats stats;
+    };
+
+    void runTasks(int numTasks, TaskFn fn, const void *ctx);
+    bool popTask(int worker, Task& task);
+    void runTask(int worker, const Task& task);
+    void workLoop(int worker);
+
+    std::vector<Worker*> mWorkers;
+
+    // tasks of the current batch not finished yet; padded rather than
+    // `alignas` so `JobPool` itself isn't over-aligned (plain `new` is fine)
+    char mPad0[CACHE_LINE];
+    std::atomic<int> mRemaining;
+    char mPad1[CACHE_LINE];
+
+    // wakes idle workers when a new batch is posted
+    std::mutex mWakeLock;
+    std::condition_variable mWake;
+    uint64_t mEpoch = 0;
+    bool mQuit = false;
+};
@@ -0,0 +1,79 @@
+/**
+ * -----------------------------------------------------------------------------
+ * LevelStream.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "core/LevelStream.hpp"
+
+
+LevelStream::LevelStream(uint64_t seed)
+{
+    this->mSeed = seed;
+    for (auto& chunk : this->mChunks)
+        chunk.store(nullptr, std::memory_order_relaxed);
+    this->mNumChunks.store(0, std::memory_order_relaxed);
+}
+
+LevelStream::~LevelStream()
+{
+    this->reset(this->mSeed);
+
+    Chunk *chunk = this->mFree;
+    while (chunk)
+    {
+        Chunk *next = chunk->nextFree;
+        delete chunk;
+        chunk = next;
+    }
+}
+
+void LevelStream::reset(uint64_t seed)
+{
+    for (auto& slot : this->mChunks)
+    {
+        Chunk *chunk = slot.exchange(nullptr, std::memory_order_relaxed);
+        if (chunk)
+            this->pushFree(chunk);
+    }
+    this->mNumChunks.store(0, std::memory_order_relaxed);
+    this->mSeed = seed;
+}
+
+const LevelStream::Chunk *LevelStream::build(int c) const
+{
+    // reuse a chunk from an earlier level if there is one
+    Chunk *chunk = this->popFree();
+    if (!chunk)
+        chunk = new Chunk();
+
+    Level::fillPipes(this->mSeed, c * LEVEL_CHUNK_SIZE, LEVEL_CHUNK_SIZE, chunk->x, chunk->y);
+
+    // publish; if another thread got there first, use its (identical) copy
+    // and keep ours for a later build
+    Chunk *expected = nullptr;
+    if (!this->mChunks[c].compare_exchange_strong(
+            expected, chunk, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        this->pushFree(chunk);
+        return expected;
+    }
+
+    this->mNumChunks.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+LevelStream::Chunk *LevelStream::popFree() const
+{
+    std::lock_guard<std::mutex> lock(this->mFreeLock);
+    Chunk *chunk = this->mFree;
+    if (chunk)
+        this->mFree = chunk->nextFree;
+    return chunk;
+}
+
+void LevelStream::pushFree(Chunk *chunk) const
+{
+    std::lock_guard<std::mutex> lock(this->mFreeLock);
+    chunk->nextFree = this->mFree;
+    this->mFree = chunk;
+}
@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------------------------------
+ * LevelStream.hpp
+ * - random access to the pipes of one level (see `Level`): pipe `k` is a
+ *   pure function of (seed, k), computed in chunks on first use and cached.
+ * - reads are lock-free and may come from any number of threads; a chunk is
+ *   built by whichever thread needs it first and published with a CAS (a
+ *   losing thread returns its copy to the free list), so one stream can back
+ *   every environment / view playing the same seed.
+ * - `reset()` keeps the chunks it drops in a free list that later builds
+ *   reuse, so replaying levels doesn't allocate once the cache is warm;
+ *   chunks are only ever deleted by the destructor.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+
+
+#define LEVEL_CHUNK_BITS    8
+#define LEVEL_CHUNK_SIZE    (1 << LEVEL_CHUNK_BITS) // pipes per chunk
+#define LEVEL_MAX_CHUNKS    4096 // cached pipes: 1M; later ones are computed
+
+
+class LevelStream
+{
+public:
+    LevelStream(uint64_t seed = rng::DEFAULT_SEED);
+    ~LevelStream();
+
+    LevelStream(const LevelStream&) = delete;
+    LevelStream& operator=(const LevelStream&) = delete;
+
+    uint64_t seed() const { return this->mSeed; }
+
+    // switch to another level; NOT thread-safe (no concurrent readers)
+    void reset(uint64_t seed);
+
+    // pipe `k` (k >= 0), same value as `Level::pipe(seed, k)`
+    Vec2f pipe(int k) const
+    {
+        assert(k >= 0);
+        int c = k >> LEVEL_CHUNK_BITS;
+        if (c >= LEVEL_MAX_CHUNKS)
+            return Level::pipe(this->mSeed, k);
+
+        const Chunk *chunk = this->mChunks[c].load(std::memory_order_acquire);
+        if (!chunk)
+            chunk = this->build(c);
+
+        int i = k & (LEVEL_CHUNK_SIZE - 1);
+        return Vec2f(chunk->x[i], chunk->y[i]);
+    }
+
+    // first pipe whose right edge can be at or right of world `x`
+    static int firstPipeAfter(float x)
+    {
+        int k = (int)floorf((x - pipeWidth - pipeJitter - initialPipeX) / pipeSpacing);
+        return k > 0 ? k : 0;
+    }
+
+    // chunks built so far (stats)
+    int numChunks() const { return this->mNumChunks.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk
+    {
+        float x[LEVEL_CHUNK_SIZE];
+        float y[LEVEL_CHUNK_SIZE];
+        Chunk *nextFree;
+    };
+
+    const Chunk *build(int c) const;
+
+    uint64_t mSeed;
+    mutable std::atomic<Chunk *> mChunks[LEVEL_MAX_CHUNKS];
+    mutable std::atomic<int> mNumChunks;
+    // chunks dropped by `reset()` / lost publish races; builds are rare
+    // (once per chunk and level), so a lock is cheaper than getting a
+    // lock-free pop safe against concurrent pop + push back
+    mutable std::mutex mFreeLock;
+    mutable Chunk *mFree = nullptr;
+
+    Chunk *popFree() const;
+    void pushFree(Chunk *chunk) const;
+};
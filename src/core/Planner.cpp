@@ -0,0 +1,214 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Planner.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <chrono>
+
+#include "core/Planner.hpp"
+#include "core/Sim.hpp"
+
+
+// states expanded per `JobPool` task
+static const int EXPAND_CHUNK = 16;
+
+
+/**
+ * heuristic: pipes passed dominate, then ticks survived, then how close the
+ * bird is to the centre of the next gap
+ */
+static float evaluate(const GameState& gameState, int aliveTicks, bool alive)
+{
+    if (!alive)
+        return -1e6f + aliveTicks;
+
+    float birdWorldX = birdX + gameState.xOffset;
+    float gapY = floorY / 2;
+    float nextX = 0;
+    for (int k = gameState.pipeHead; k < gameState.pipeHead + 2; k++)
+    {
+        auto& pipe = gameState.pipe(k);
+        bool ahead = pipe.x + pipeWidth > birdWorldX - birdSize;
+        if (ahead && (nextX == 0 || pipe.x < nextX))
+        {
+            nextX = pipe.x;
+            gapY = pipe.y;
+        }
+    }
+
+    return gameState.score * 1000.f + aliveTicks - fabsf(gameState.birdY - gapY);
+}
+
+
+Planner::Planner(const PlannerConfig& config)
+{
+    this->mConfig = config;
+    assert(config.horizon > 0 && config.actionRepeat > 0 && config.beamWidth > 0);
+
+    if (config.threads > 1)
+    {
+        // a level is at most `beamWidth` parents
+        this->mPool = new JobPool(config.threads);
+        this->mPool->reserve((config.beamWidth + EXPAND_CHUNK - 1) / EXPAND_CHUNK);
+    }
+
+    this->mParents.resize(config.beamWidth);
+    this->mChildren.resize(config.beamWidth * 2);
+    this->mOrder.resize(config.beamWidth * 2);
+}
+
+Planner::~Planner()
+{
+    delete this->mPool;
+}
+
+// children `2i` (no flap) and `2i + 1` (flap) of parents [begin, end)
+void Planner::expand(int begin, int end, int numParents, int repeat)
+{
+    for (int i = begin; i < end && i < numParents; i++)
+    {
+        const Node& parent = this->mParents[i];
+
+        for (int action = 0; action < 2; action++)
+        {
+            Node& child = this->mChildren[2 * i + action];
+            child = parent;
+
+            // dead lines aren't stepped again; they're carried along (once)
+            // so the longest-surviving one still wins if every line dies
+            if (!parent.alive)
+            {
+                if (action == 1)
+                    child.value = -2e6f;
+                continue;
+            }
+
+            for (int t = 0; t < repeat && child.alive; t++)
+            {
+                Sim::step(child.state, action == 1 && t == 0);
+                child.alive = child.state.running == RunningT::Running;
+                child.aliveTicks += child.alive;
+            }
+            child.value = evaluate(child.state, child.aliveTicks, child.alive);
+        }
+    }
+}
+
+PlanResult Planner::plan(const GameState& gameState, int budgetMicros)
+{
+    using namespace std::chrono;
+
+    auto start = steady_clock::now();
+    auto elapsedMicros = [&]() {
+        return (int)duration_cast<microseconds>(steady_clock::now() - start).count();
+    };
+
+    PlanResult result;
+
+    // only a running game has decisions to make; otherwise press to restart
+    if (gameState.running != RunningT::Running)
+    {
+        result.flap = gameState.running == RunningT::Restart;
+        return result;
+    }
+
+    const PlannerConfig& cfg = this->mConfig;
+
+    // root
+    Node& root = this->mParents[0];
+    root.state = gameState;
+    root.aliveTicks = 0;
+    root.alive = true;
+    root.firstFlap = false;
+    root.value = 0;
+    int numParents = 1;
+
+    bool firstLevel = true;
+
+    while (result.depth < cfg.horizon)
+    {
+        if (budgetMicros > 0 && !firstLevel && elapsedMicros() >= budgetMicros)
+            break;
+
+        int repeat = Math::min(cfg.actionRepeat, cfg.horizon - result.depth);
+
+        /**
+         * expand every parent into (no flap, flap)
+         */
+        if (this->mPool && numParents > EXPAND_CHUNK)
+        {
+            int numTasks = (numParents + EXPAND_CHUNK - 1) / EXPAND_CHUNK;
+            this->mPool->run(numTasks, [&](int task, int) {
+                this->expand(task * EXPAND_CHUNK, (task + 1) * EXPAND_CHUNK, numParents, repeat);
+            });
+        }
+        else
+        {
+            this->expand(0, numParents, numParents, repeat);
+        }
+
+        int numChildren = numParents * 2;
+        result.nodes += numChildren;
+
+        // the action at the root is whatever the first level chose
+        if (firstLevel)
+        {
+            for (int i = 0; i < numChildren; i++)
+                this->mChildren[i].firstFlap = (i & 1) != 0;
+            firstLevel = false;
+        }
+
+        /**
+         * keep the best `beamWidth` distinct children; different input
+         * sequences often reach the same bird state (e.g. pinned to the
+         * ceiling), and duplicates would crowd out the alternatives
+         */
+        for (int i = 0; i < numChildren; i++)
+            this->mOrder[i] = i;
+
+        auto better = [&](int a, int b) {
+            const Node& na = this->mChildren[a];
+            const Node& nb = this->mChildren[b];
+            if (na.value != nb.value) return na.value > nb.value;
+            if (na.state.birdY != nb.state.birdY) return na.state.birdY < nb.state.birdY;
+            return na.state.birdVY < nb.state.birdVY;
+        };
+        std::sort(this->mOrder.begin(), this->mOrder.begin() + numChildren, better);
+
+        int keep = 0;
+        const Node *last = nullptr;
+        for (int i = 0; i < numChildren && keep < cfg.beamWidth; i++)
+        {
+            const Node& child = this->mChildren[this->mOrder[i]];
+            bool duplicate = last && (
+                child.value == last->value &&
+                child.state.birdY == last->state.birdY &&
+                child.state.birdVY == last->state.birdVY
+            );
+            if (duplicate)
+                continue;
+
+            this->mParents[keep++] = child;
+            last = &child;
+        }
+        numParents = keep;
+
+        result.depth += repeat;
+    }
+
+    /**
+     * pick the best surviving line
+     */
+    const Node *best = &this->mParents[0];
+    for (int i = 1; i < numParents; i++)
+        if (this->mParents[i].value > best->value)
+            best = &this->mParents[i];
+
+    result.flap = best->firstFlap;
+    result.value = best->value;
+    result.survives = best->alive;
+    result.micros = elapsedMicros();
+
+    return result;
+}
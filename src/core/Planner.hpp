@@ -0,0 +1,72 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Planner.hpp
+ * - lookahead planner over flap / no-flap inputs: beam search over cloned
+ *   `GameState`s stepped with `Sim::step()`. Used as an autopilot and as a
+ *   difficulty oracle (`PlanResult::survives`).
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+#include "core/JobPool.hpp"
+
+
+struct PlannerConfig
+{
+    int horizon = 90;       // ticks to look ahead
+    int actionRepeat = 2;   // ticks per decision (the tree branches every N ticks);
+                            // > 2 is too coarse to time flaps through a gap
+    int beamWidth = 64;     // distinct nodes kept per decision level
+    int threads = 1;        // > 1 expands each level across a `JobPool`
+};
+
+struct PlanResult
+{
+    bool flap = false;      // input for the next tick
+    float value = 0;        // heuristic value of the best line found
+    int depth = 0;          // ticks searched before the budget ran out
+    int nodes = 0;          // states expanded
+    bool survives = false;  // best line is still alive at `depth`
+    int micros = 0;         // time spent
+};
+
+
+class Planner
+{
+public:
+    Planner(const PlannerConfig& config = PlannerConfig());
+    ~Planner();
+
+    Planner(const Planner&) = delete;
+    Planner& operator=(const Planner&) = delete;
+
+    const PlannerConfig& config() const { return this->mConfig; }
+
+    // best input for the next tick of `gameState`; returns once the horizon
+    // is searched or `budgetMicros` is used up (0 = no limit), whichever is
+    // first. allocation-free after construction (threaded too: `JobPool`
+    // runs take the expand lambda by reference into reserved deques).
+    PlanResult plan(const GameState& gameState, int budgetMicros = 0);
+
+private:
+    struct Node
+    {
+        GameState state;
+        float value;
+        int aliveTicks;
+        bool firstFlap;     // action taken at the root
+        bool alive;
+    };
+
+    void expand(int begin, int end, int numParents, int repeat);
+
+    PlannerConfig mConfig;
+    JobPool *mPool = nullptr;
+
+    // double-buffered beam: `mParents` -> 2 children each in `mChildren`
+    AlignedArray<Node> mParents;
+    AlignedArray<Node> mChildren;
+    AlignedArray<int> mOrder;
+};
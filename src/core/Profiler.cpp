@@ -0,0 +1,258 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Profiler.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <time.h>
+#include <mutex>
+
+#include "core/Profiler.hpp"
+
+
+uint64_t Profiler::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+
+#if PROFILER_ENABLED
+
+/**
+ * one ring per thread, written by that thread only; readers on other
+ * threads go through the atomics and drop events the writer may have lapped
+ */
+struct ProfileEvent
+{
+    std::atomic<const char *> name;
+    std::atomic<uint64_t> start;
+    std::atomic<uint64_t> end;
+    std::atomic<int> depth;
+};
+
+struct ProfileRing
+{
+    std::atomic<const char *> threadName;
+    std::atomic<uint64_t> head;     // events written so far
+    int depth;                      // open scopes (owner thread only)
+    ProfileEvent events[PROFILER_RING_SIZE];
+};
+
+static std::atomic<ProfileRing *> gRings[PROFILER_MAX_THREADS];
+static std::atomic<int> gNumRings(0);
+static std::mutex gRegisterMutex;
+static const uint64_t gEpoch = Profiler::now();
+
+static thread_local ProfileRing *tRing = nullptr;
+static thread_local bool tNoRing = false;
+
+static ProfileRing *thread_ring()
+{
+    if (tRing || tNoRing)
+        return tRing;
+
+    // first scope on this thread: register a ring (kept for the process'
+    // lifetime, exports may still read it after the thread is gone)
+    std::lock_guard<std::mutex> lock(gRegisterMutex);
+    int index = gNumRings.load(std::memory_order_relaxed);
+    if (index >= PROFILER_MAX_THREADS)
+    {
+        tNoRing = true;
+        return nullptr;
+    }
+
+    tRing = new ProfileRing(); // zeroed
+    gRings[index].store(tRing, std::memory_order_release);
+    gNumRings.store(index + 1, std::memory_order_release);
+    return tRing;
+}
+
+// event `i` of `ring`, false if it was (or may have been) overwritten
+static bool read_event(ProfileRing *ring, uint64_t i, const char **name, uint64_t *start, uint64_t *end, int *depth)
+{
+    auto& e = ring->events[i & (PROFILER_RING_SIZE - 1)];
+    *name = e.name.load(std::memory_order_relaxed);
+    *start = e.start.load(std::memory_order_relaxed);
+    *end = e.end.load(std::memory_order_relaxed);
+    *depth = e.depth.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    return *name && head - i < PROFILER_RING_SIZE;
+}
+
+
+bool Profiler::enabled() { return true; }
+
+void Profiler::nameThread(const char *name)
+{
+    ProfileRing *ring = thread_ring();
+    if (ring)
+        ring->threadName.store(name, std::memory_order_relaxed);
+}
+
+const char *Profiler::threadName(int thread)
+{
+    if (thread < 0 || thread >= gNumRings.load(std::memory_order_acquire))
+        return nullptr;
+    return gRings[thread].load(std::memory_order_acquire)->threadName.load(std::memory_order_relaxed);
+}
+
+int Profiler::enter()
+{
+    ProfileRing *ring = thread_ring();
+    if (!ring)
+        return -1;
+    return ring->depth++;
+}
+
+void Profiler::leave(const char *name, uint64_t start, int depth)
+{
+    if (depth < 0)
+        return;
+
+    uint64_t end = Profiler::now();
+    ProfileRing *ring = tRing;
+    ring->depth--;
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    auto& e = ring->events[head & (PROFILER_RING_SIZE - 1)];
+    e.name.store(name, std::memory_order_relaxed);
+    e.start.store(start, std::memory_order_relaxed);
+    e.end.store(end, std::memory_order_relaxed);
+    e.depth.store(depth, std::memory_order_relaxed);
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+int Profiler::summarize(double windowMs, ProfileStat *out, int maxStats)
+{
+    // first start of each entry, to list them in call order
+    const int MAX_SORTED = 64;
+    uint64_t firstStart[MAX_SORTED];
+    maxStats = maxStats < MAX_SORTED ? maxStats : MAX_SORTED;
+
+    uint64_t since = Profiler::now() - (uint64_t)(windowMs * 1e6);
+    int numStats = 0;
+
+    int numRings = gNumRings.load(std::memory_order_acquire);
+    for (int t = 0; t < numRings; t++)
+    {
+        ProfileRing *ring = gRings[t].load(std::memory_order_acquire);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t count = head < PROFILER_RING_SIZE ? head : PROFILER_RING_SIZE;
+
+        // newest first, until events are older than the window
+        for (uint64_t i = head; i-- > head - count; )
+        {
+            const char *name;
+            uint64_t start, end;
+            int depth;
+            if (!read_event(ring, i, &name, &start, &end, &depth) || end < since)
+                break;
+
+            int s = 0;
+            while (s < numStats && !(out[s].thread == t && out[s].name == name && out[s].depth == depth))
+                s++;
+            if (s == numStats)
+            {
+                if (numStats == maxStats)
+                    continue;
+                out[s] = ProfileStat();
+                out[s].name = name;
+                out[s].thread = t;
+                out[s].depth = depth;
+                numStats++;
+            }
+            out[s].calls++;
+            out[s].totalMs += (end - start) * 1e-6;
+            firstStart[s] = start;
+        }
+    }
+
+    // insertion sort by (thread, first start)
+    for (int i = 1; i < numStats; i++)
+    {
+        ProfileStat stat = out[i];
+        uint64_t key = firstStart[i];
+        int j = i - 1;
+        while (j >= 0 && (out[j].thread > stat.thread ||
+            (out[j].thread == stat.thread && firstStart[j] > key)))
+        {
+            out[j + 1] = out[j];
+            firstStart[j + 1] = firstStart[j];
+            j--;
+        }
+        out[j + 1] = stat;
+        firstStart[j + 1] = key;
+    }
+
+    return numStats;
+}
+
+bool Profiler::exportTrace(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    long events = 0;
+
+    int numRings = gNumRings.load(std::memory_order_acquire);
+    for (int t = 0; t < numRings; t++)
+    {
+        ProfileRing *ring = gRings[t].load(std::memory_order_acquire);
+
+        const char *threadName = ring->threadName.load(std::memory_order_relaxed);
+        char fallback[32];
+        if (!threadName)
+        {
+            snprintf(fallback, sizeof(fallback), "thread %d", t);
+            threadName = fallback;
+        }
+        fprintf(file,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", t, threadName
+        );
+        first = false;
+
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t count = head < PROFILER_RING_SIZE ? head : PROFILER_RING_SIZE;
+        for (uint64_t i = head - count; i < head; i++)
+        {
+            const char *name;
+            uint64_t start, end;
+            int depth;
+            if (!read_event(ring, i, &name, &start, &end, &depth))
+                continue;
+
+            fprintf(file,
+                ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                name, t, (start - gEpoch) * 1e-3, (end - start) * 1e-3
+            );
+            events++;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    bool ok = (ferror(file) == 0);
+    ok = (fclose(file) == 0) && ok;
+
+    if (ok)
+        printlog(0, "exported %ld profiler events to %s", events, path);
+    return ok;
+}
+
+#else
+
+bool Profiler::enabled() { return false; }
+void Profiler::nameThread(const char *name) {}
+const char *Profiler::threadName(int thread) { return nullptr; }
+int Profiler::enter() { return -1; }
+void Profiler::leave(const char *name, uint64_t start, int depth) {}
+int Profiler::summarize(double windowMs, ProfileStat *out, int maxStats) { return 0; }
+bool Profiler::exportTrace(const char *path) { return false; }
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Profiler.hpp
+ * - nestable scoped timers: `PROFILE_SCOPE("name")` records one event
+ *   (start, end, depth) into a ring buffer owned by the calling thread when
+ *   the scope exits. Recording is a couple of `clock_gettime()` calls and a
+ *   few stores, no locks.
+ * - rings can be summarized live (`summarize()`) or dumped as Chrome
+ *   `trace_event` JSON (`exportTrace()`, open in chrome://tracing or
+ *   https://ui.perfetto.dev) from any thread
+ * - compiled out unless `PROFILER_ENABLED` (default: `DEBUG` builds)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+#include "core/core.hpp"
+
+
+#ifndef PROFILER_ENABLED
+    #define PROFILER_ENABLED DEBUG
+#endif
+
+#define PROFILER_RING_BITS      14  // events kept per thread: 16k
+#define PROFILER_RING_SIZE      (1 << PROFILER_RING_BITS)
+#define PROFILER_MAX_THREADS    16  // threads past this record nothing
+
+
+// aggregate of one scope (name + thread + depth) over a time window
+struct ProfileStat
+{
+    const char *name = nullptr;
+    int thread = 0;
+    int depth = 0;
+    int calls = 0;
+    double totalMs = 0;
+
+    double avgMs() const { return this->calls ? this->totalMs / this->calls : 0; }
+};
+
+
+class Profiler
+{
+public:
+    static bool enabled();
+
+    // monotonic clock (ns)
+    static uint64_t now();
+
+    // label the calling thread in exported traces (e.g. "sim"); `name`
+    // must outlive the profiler (a literal)
+    static void nameThread(const char *name);
+    // label of ring `thread` (see `ProfileStat::thread`), nullptr if unnamed
+    static const char *threadName(int thread);
+
+    // scopes that ended within the last `windowMs`, one entry per
+    // (thread, name, depth) in first-seen order; returns the entry count
+    static int summarize(double windowMs, ProfileStat *out, int maxStats);
+
+    // every event still in the rings as Chrome `trace_event` JSON
+    static bool exportTrace(const char *path);
+
+    /**
+     * used by `ProfileScope`
+     */
+    static int enter();
+    static void leave(const char *name, uint64_t start, int depth);
+};
+
+
+class ProfileScope
+{
+public:
+    ProfileScope(const char *name)
+        : mName(name), mDepth(Profiler::enter()), mStart(Profiler::now())
+    {}
+
+    ~ProfileScope()
+    {
+        Profiler::leave(this->mName, this->mStart, this->mDepth);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char *mName;
+    int mDepth;
+    uint64_t mStart;
+};
+
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#if PROFILER_ENABLED
+    // `name` must be a string literal (only the pointer is stored)
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+    #define PROFILE_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,278 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Replay.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <limits.h>
+
+#include "core/Replay.hpp"
+#include "core/Sim.hpp"
+
+
+static void write_varint(std::vector<uint8_t>& out, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+// returns the number of bytes read, 0 on a truncated stream
+static uint32_t read_varint(const uint8_t *data, uint32_t size, uint32_t& value)
+{
+    value = 0;
+    for (uint32_t i = 0; i < size && i < 5; i++)
+    {
+        value |= (uint32_t)(data[i] & 0x7f) << (7 * i);
+        if (!(data[i] & 0x80))
+            return i + 1;
+    }
+    return 0;
+}
+
+
+/**
+ * Replay
+ */
+bool Replay::save(const char *path) const
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        printlog(1, "replay: cannot write '%s'", path);
+        return false;
+    }
+
+    bool ok =
+        fwrite(&this->header, sizeof(ReplayHeader), 1, file) == 1 &&
+        fwrite(this->inputs.data(), 1, this->inputs.size(), file) == this->inputs.size() &&
+        fwrite(this->keyframes.data(), sizeof(ReplayKeyframe), this->keyframes.size(), file) == this->keyframes.size() &&
+        fwrite(this->states.data(), 1, this->states.size(), file) == this->states.size();
+    fclose(file);
+
+    if (!ok)
+        printlog(1, "replay: short write to '%s'", path);
+    return ok;
+}
+
+bool Replay::load(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        printlog(1, "replay: cannot open '%s'", path);
+        return false;
+    }
+
+    ReplayHeader header;
+    bool ok = fread(&header, sizeof(ReplayHeader), 1, file) == 1;
+    if (ok && (header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION ||
+               header.stateSize != sizeof(GameState)))
+    {
+        printlog(1, "replay: '%s' is not a replay for this build", path);
+        ok = false;
+    }
+
+    if (ok)
+    {
+        this->header = header;
+        this->inputs.resize(header.inputBytes);
+        this->keyframes.resize(header.numKeyframes);
+        this->states.resize((size_t)header.numKeyframes * header.stateSize);
+
+        ok =
+            fread(this->inputs.data(), 1, this->inputs.size(), file) == this->inputs.size() &&
+            fread(this->keyframes.data(), sizeof(ReplayKeyframe), this->keyframes.size(), file) == this->keyframes.size() &&
+            fread(this->states.data(), 1, this->states.size(), file) == this->states.size();
+        if (!ok)
+            printlog(1, "replay: '%s' is truncated", path);
+    }
+    fclose(file);
+
+    if (!ok)
+        *this = Replay();
+    return ok;
+}
+
+bool Replay::next(ReplayCursor& cursor) const
+{
+    uint32_t size = (uint32_t)this->inputs.size();
+    if (cursor.offset >= size)
+        return false; // trailing idle run isn't stored
+
+    uint32_t run;
+    uint32_t bytes = read_varint(&this->inputs[cursor.offset], size - cursor.offset, run);
+    if (bytes == 0)
+        return false;
+
+    if (cursor.idleDone < run)
+    {
+        cursor.idleDone++;
+        return false;
+    }
+
+    cursor.offset += bytes;
+    cursor.idleDone = 0;
+    return true;
+}
+
+int Replay::idleAhead(const ReplayCursor& cursor) const
+{
+    uint32_t size = (uint32_t)this->inputs.size();
+    if (cursor.offset >= size)
+        return INT_MAX;
+
+    uint32_t run;
+    if (read_varint(&this->inputs[cursor.offset], size - cursor.offset, run) == 0)
+        return INT_MAX;
+    return (int)(run - cursor.idleDone);
+}
+
+int Replay::keyframeFor(int tick) const
+{
+    // keyframes are sorted by tick and the first one is tick 0
+    int lo = 0, hi = (int)this->keyframes.size() - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if ((int)this->keyframes[mid].tick <= tick)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+void Replay::restore(int keyframe, GameState& gameState) const
+{
+    memcpy(&gameState, &this->states[(size_t)keyframe * this->header.stateSize], sizeof(GameState));
+}
+
+
+/**
+ * ReplayRecorder
+ */
+void ReplayRecorder::begin(const GameState& gameState, int keyframeInterval, int maxTicks)
+{
+    // keep the buffers: starting over at `maxTicks` mustn't allocate
+    auto& replay = this->replay;
+    replay.header = ReplayHeader();
+    replay.header.seed = gameState.seed;
+    replay.header.keyframeInterval = (uint32_t)keyframeInterval;
+    replay.inputs.clear();
+    replay.keyframes.clear();
+    replay.states.clear();
+    this->mIdleRun = 0;
+    this->mMaxTicks = maxTicks;
+
+    // worst case: a flap every tick (a 1 byte varint each)
+    int numKeyframes = (maxTicks + keyframeInterval - 1) / keyframeInterval;
+    replay.inputs.reserve(maxTicks);
+    replay.keyframes.reserve(numKeyframes);
+    replay.states.reserve((size_t)numKeyframes * sizeof(GameState));
+}
+
+void ReplayRecorder::record(const GameState& gameState, bool flap)
+{
+    auto& replay = this->replay;
+    auto& header = replay.header;
+
+    if ((int)header.tickCount >= this->mMaxTicks)
+        this->begin(gameState, (int)header.keyframeInterval, this->mMaxTicks);
+
+    if (header.tickCount % header.keyframeInterval == 0)
+    {
+        ReplayKeyframe keyframe;
+        keyframe.tick = header.tickCount;
+        keyframe.cursor.offset = (uint32_t)replay.inputs.size();
+        keyframe.cursor.idleDone = this->mIdleRun;
+        replay.keyframes.push_back(keyframe);
+
+        auto bytes = (const uint8_t *)&gameState;
+        replay.states.insert(replay.states.end(), bytes, bytes + sizeof(GameState));
+        header.numKeyframes++;
+    }
+
+    if (flap)
+    {
+        write_varint(replay.inputs, this->mIdleRun);
+        this->mIdleRun = 0;
+        header.flapCount++;
+        header.inputBytes = (uint32_t)replay.inputs.size();
+    }
+    else
+        this->mIdleRun++;
+
+    header.tickCount++;
+}
+
+
+/**
+ * ReplayPlayer
+ */
+void ReplayPlayer::begin(const Replay *replay)
+{
+    this->mReplay = replay;
+    this->tick = -1; // forces a keyframe restore
+    this->seek(0);
+}
+
+bool ReplayPlayer::step()
+{
+    bool flap;
+    if (!this->input(flap))
+        return false;
+
+    Sim::step(this->gameState, flap);
+    return true;
+}
+
+bool ReplayPlayer::input(bool& flap)
+{
+    if (this->finished())
+        return false;
+
+    flap = this->mReplay->next(this->mCursor);
+    this->tick++;
+    return true;
+}
+
+void ReplayPlayer::seek(int tick)
+{
+    if (!this->mReplay || this->mReplay->keyframes.empty())
+    {
+        this->gameState = GameState(this->mReplay ? this->mReplay->header.seed : rng::DEFAULT_SEED);
+        this->tick = 0;
+        this->mCursor = ReplayCursor();
+        return;
+    }
+
+    if (tick < 0) tick = 0;
+    if (tick > this->mReplay->tickCount()) tick = this->mReplay->tickCount();
+
+    // stepping forward from the current position beats a keyframe restore
+    // when the target is closer than the next keyframe
+    int keyframe = this->mReplay->keyframeFor(tick);
+    if (tick < this->tick || (int)this->mReplay->keyframes[keyframe].tick > this->tick)
+    {
+        this->mReplay->restore(keyframe, this->gameState);
+        this->tick = (int)this->mReplay->keyframes[keyframe].tick;
+        this->mCursor = this->mReplay->keyframes[keyframe].cursor;
+    }
+
+    while (this->tick < tick)
+    {
+        int idle = std::min(this->mReplay->idleAhead(this->mCursor), tick - this->tick);
+        if (idle > 0)
+        {
+            int ticks = Sim::fastForward(this->gameState, idle);
+            this->mCursor.idleDone += ticks;
+            this->tick += ticks;
+        }
+        else
+            this->step();
+    }
+}
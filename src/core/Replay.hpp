@@ -0,0 +1,142 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Replay.hpp
+ * - deterministic input recording / playback. A replay is the starting
+ *   `GameState` + one flap bit per tick; the sim is deterministic (see
+ *   `Level`, `rng::`), so that's enough to reproduce a session exactly.
+ *
+ * file layout (host byte order, i.e. little endian on every target):
+ *   ReplayHeader
+ *   input stream:   one LEB128 varint per flap = idle ticks before it, so
+ *                   long idle stretches cost a byte or two
+ *   keyframe table: `numKeyframes` x ReplayKeyframe, one every
+ *                   `keyframeInterval` ticks, for O(log n) seeking
+ *   keyframe states: `numKeyframes` x `stateSize` raw `GameState` bytes
+ *
+ * NOTE: keyframes are raw `GameState` bytes, so replay files are only
+ * portable between builds with the same `GameState` layout (`stateSize`
+ * and `version` are checked on load)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+
+
+#define REPLAY_MAGIC        0x52504c46 // "FLPR"
+#define REPLAY_VERSION      3
+// recorder capacity: one hour at 60 ticks/s, reserved up front
+#define REPLAY_MAX_TICKS    (60 * 60 * 60)
+
+
+struct ReplayHeader
+{
+    uint32_t magic = REPLAY_MAGIC;
+    uint32_t version = REPLAY_VERSION;
+    uint32_t stateSize = sizeof(GameState);
+    uint32_t keyframeInterval = 0;
+    uint64_t seed = 0;
+    uint32_t tickCount = 0;
+    uint32_t flapCount = 0;
+    uint32_t inputBytes = 0;
+    uint32_t numKeyframes = 0;
+};
+
+// position in the input stream
+struct ReplayCursor
+{
+    uint32_t offset = 0;        // byte offset of the pending run's varint
+    uint32_t idleDone = 0;      // idle ticks of that run already consumed
+};
+
+// the matching `GameState` (before `tick` is stepped) lives in
+// `Replay::states`, `stateSize` bytes per keyframe
+struct ReplayKeyframe
+{
+    uint32_t tick = 0;
+    ReplayCursor cursor;
+};
+
+
+/**
+ * in-memory replay (recorded or loaded)
+ */
+class Replay
+{
+public:
+    ReplayHeader header;
+    std::vector<uint8_t> inputs;
+    std::vector<ReplayKeyframe> keyframes;
+    std::vector<uint8_t> states;
+
+    int tickCount() const { return (int)this->header.tickCount; }
+
+    bool save(const char *path) const;
+    bool load(const char *path);
+
+    // consume one tick; returns its flap bit
+    bool next(ReplayCursor& cursor) const;
+    // idle ticks before the next flap (INT_MAX once the stream is exhausted)
+    int idleAhead(const ReplayCursor& cursor) const;
+    // index of the last keyframe at or before `tick` (binary search)
+    int keyframeFor(int tick) const;
+    void restore(int keyframe, GameState& gameState) const;
+};
+
+
+/**
+ * records one flap bit per tick; call `record()` right before each
+ * `Sim::step()` with the state about to be stepped
+ * - everything `maxTicks` ticks need is reserved by `begin()`, so recording
+ *   never allocates; a recording that reaches `maxTicks` starts over from
+ *   the current state in the same buffers (the replay keeps the latest
+ *   stretch of the session)
+ */
+class ReplayRecorder
+{
+public:
+    Replay replay;
+
+    void begin(const GameState& gameState, int keyframeInterval = 600, int maxTicks = REPLAY_MAX_TICKS);
+    void record(const GameState& gameState, bool flap);
+
+private:
+    uint32_t mIdleRun = 0;
+    int mMaxTicks = REPLAY_MAX_TICKS;
+};
+
+
+/**
+ * feeds a replay back through `Sim::step()`; the replay must outlive the
+ * player
+ */
+class ReplayPlayer
+{
+public:
+    GameState gameState;
+    int tick = 0;
+
+    void begin(const Replay *replay);
+
+    bool finished() const { return !this->mReplay || this->tick >= this->mReplay->tickCount(); }
+
+    // advance one tick; false once the replay has ended
+    bool step();
+    // the next tick's input, without stepping `gameState` (for a caller
+    // that steps its own copy, e.g. through the game's tick); false once
+    // the replay has ended
+    bool input(bool& flap);
+
+    // jump to the state before `tick`: restores the closest keyframe and
+    // re-simulates at most `keyframeInterval` ticks (idle runs in jumps,
+    // see `Sim::fastForward()`)
+    void seek(int tick);
+
+private:
+    const Replay *mReplay = nullptr;
+    ReplayCursor mCursor;
+};
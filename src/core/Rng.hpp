@@ -0,0 +1,61 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Rng.hpp
+ * - stateless, counter-based random numbers: every draw is a pure function of
+ *   (seed, counter), so there is no hidden global state, draws can be made in
+ *   any order / on any thread, and batch fills vectorize (32-bit ops only).
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+
+
+namespace rng
+{
+    // default seed for `GameState()` when none is given
+    const uint64_t DEFAULT_SEED = 0x5eed;
+
+    // `lowbias32` finalizer (see: https://nullprogram.com/blog/2018/07/31/)
+    inline uint32_t mix32(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // SplitMix64 finalizer; used to derive new seeds from old ones
+    inline uint64_t mix64(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // 32 random bits for draw number `counter` of stream `seed`
+    // (two keyed rounds, one per seed half)
+    inline uint32_t hash(uint64_t seed, uint32_t counter)
+    {
+        uint32_t x = mix32(counter * 0x9e3779b9U + (uint32_t)seed);
+        return mix32(x ^ (uint32_t)(seed >> 32));
+    }
+
+    // float in [0, 1) from the top 24 bits
+    inline float unit(uint32_t bits)
+    {
+        return (float)(bits >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // float in [min, max)
+    inline float range(uint64_t seed, uint32_t counter, float min, float max)
+    {
+        float range = max - min;
+        float r = rng::unit(rng::hash(seed, counter));
+
+        return min + (range * r);
+    }
+}
@@ -0,0 +1,35 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Rollout.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include "core/Rollout.hpp"
+
+
+void Rollout::stepTicks(
+    JobPool& pool,
+    BatchedGameState& batch,
+    uint8_t *flap,
+    int ticks,
+    const Policy& policy,
+    int chunkSize
+) {
+    assert(chunkSize > 0 && chunkSize % 16 == 0);
+
+    int numChunks = (batch.capacity + chunkSize - 1) / chunkSize;
+
+    pool.run(numChunks, [&](int chunk, int worker) {
+        int begin = chunk * chunkSize;
+        int end = Math::min(begin + chunkSize, batch.capacity);
+
+        for (int t = 0; t < ticks; t++)
+        {
+            policy(batch, begin, Math::min(end, batch.size), flap);
+            BatchSim::step(batch, flap, begin, end);
+        }
+
+        int lanes = Math::min(end, batch.size) - begin;
+        if (lanes > 0)
+            pool.stats(worker).steps.fetch_add((uint64_t)lanes * ticks, std::memory_order_relaxed);
+    });
+}
@@ -0,0 +1,38 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Rollout.hpp
+ * - steps a `BatchedGameState` for many ticks across a `JobPool`
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <functional>
+
+#include "core/core.hpp"
+#include "core/Batch.hpp"
+#include "core/JobPool.hpp"
+
+
+class Rollout
+{
+public:
+    // writes the flap inputs of environments [begin, end) for the next tick
+    using Policy = std::function<void (const BatchedGameState& batch, int begin, int end, uint8_t *flap)>;
+
+    // default lanes per task; a multiple of 16 keeps chunks on separate
+    // cache lines in every column
+    static const int DEFAULT_CHUNK = 256;
+
+    // step every environment `ticks` times. environments are independent, so
+    // each chunk runs all of its ticks on whichever worker picked it up with
+    // no barrier between ticks. `flap` holds one byte per env (`capacity`).
+    // env-steps are added to the pool's per-worker `steps` counters.
+    static void stepTicks(
+        JobPool& pool,
+        BatchedGameState& batch,
+        uint8_t *flap,
+        int ticks,
+        const Policy& policy,
+        int chunkSize = DEFAULT_CHUNK
+    );
+};
@@ -0,0 +1,526 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Sim.cpp
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+
+#include "core/Sim.hpp"
+#include "util/Collision.hpp"
+
+
+/**
+ * Closed-form motion
+ * ------------------
+ * `Sim::step()` doesn't accumulate positions tick by tick; the state
+ * `anchorTicks` ticks after the anchor is a direct function of it (same
+ * trajectory as semi-implicit Euler ticks). Stepping and jumping ahead
+ * (`Sim::fastForward()`) therefore produce bit-identical states.
+ */
+static const float SCROLL = speed * tickTime;
+static const float GRAVITY_V = gravity * tickTime;
+static const float GRAVITY_Y = gravity * tickTime * tickTime;
+
+static inline void at_anchor(const GameState& gameState, int m, float& x, float& y, float& vy)
+{
+    x = gameState.anchorX + (float)m * SCROLL;
+    vy = gameState.anchorVY + (float)m * GRAVITY_V;
+    y = gameState.anchorY + (float)m * (gameState.anchorVY * tickTime) + (float)(m * (m + 1) / 2) * GRAVITY_Y;
+}
+
+// restart the closed form from the current state (flap, death, ceiling)
+static inline void reanchor(GameState& gameState)
+{
+    gameState.anchorTicks = 0;
+    gameState.anchorX = gameState.xOffset;
+    gameState.anchorY = gameState.birdY;
+    gameState.anchorVY = gameState.birdVY;
+}
+
+// one tick along the anchored trajectory; `scroll` is false once dead
+static inline void advance_anchor(GameState& gameState, bool scroll)
+{
+    float x, y, vy;
+    at_anchor(gameState, ++gameState.anchorTicks, x, y, vy);
+
+    if (scroll)
+        gameState.xOffset = x;
+    gameState.birdVY = vy;
+    gameState.birdY = Math::clamp(y, birdSize, floorY - birdSize);
+
+    // stuck at the ceiling: the parabola continues from there
+    if (y < birdSize)
+        reanchor(gameState);
+}
+
+
+/**
+ * one discrete step of `dt`: move, then test for overlaps at the end;
+ * `anchored` steps (always `tickTime`) move along the closed form,
+ * the others integrate `dt` directly
+ */
+static inline void step_discrete(GameState& gameState, bool flap, float dt, bool anchored)
+{
+
+    auto update_bird = [&]()
+    {
+        // add gravity to bird vel
+        gameState.birdVY += gravity * dt;
+
+        // update bird pos
+        gameState.birdY += gameState.birdVY * dt;
+        // clamp bird pos to floor/ceil
+        gameState.birdY = Math::clamp(
+            gameState.birdY,
+            birdSize,
+            floorY - birdSize
+        );
+    };
+
+    switch (gameState.running)        
+    {
+        case RunningT::Running:
+            {
+                /**
+                 * update bird + xOffset
+                 */
+                // trigger jump
+                if (flap)
+                {
+                    gameState.birdVY = jumpForce;
+                    reanchor(gameState);
+                }
+
+                if (anchored)
+                    advance_anchor(gameState, true);
+                else
+                {
+                    gameState.xOffset += speed * dt;
+                    update_bird();
+                }
+
+                /**
+                 * update pipes
+                 * pipes are ordered by x, so only the head can leave the
+                 * screen; it's replaced by the next level pipe at the tail
+                 */
+                while (gameState.pipe(gameState.pipeHead).x - gameState.xOffset + pipeWidth <= 0.0)
+                {
+                    gameState.pipeHead++;
+                    gameState.pipe(gameState.nextPipe) = Level::pipe(gameState.seed, gameState.nextPipe);
+                    gameState.nextPipe++;
+                    // printlog(1, "update pipe! <x: %f, y: %f>", pipe.x, pipe.y);
+                }
+
+                /**
+                 * detect collisions
+                 * pipes are >= 200 apart, so only the head (possibly already
+                 * behind the bird) and the one after it can reach `birdX`
+                 */
+                bool hitPipe = false;
+                for (int k = gameState.pipeHead; k < gameState.pipeHead + 2; k++)
+                {
+                    auto& pipe = gameState.pipe(k);
+                    auto xPos = pipe.x - gameState.xOffset;
+
+                    bool topPipeCollides = Collision::circleRect(
+                        birdX, gameState.birdY, birdSize,
+                        xPos, 0, pipeWidth, pipe.y - halfGap
+                    );
+                    if (topPipeCollides)
+                    {
+                        // printlog(1, "TOP PIPE COLLIDES");
+                        hitPipe = true;
+                        break;
+                    }
+
+                    bool btmPipeCollides = Collision::circleRect(
+                        birdX, gameState.birdY, birdSize,
+                        xPos, pipe.y + halfGap, pipeWidth, floorY
+                    );
+                    if (btmPipeCollides)
+                    {
+                        // printlog(1, "BTM PIPE COLLIDES");
+                        hitPipe = true;
+                        break;
+                    }
+                }
+
+                bool hitFloor = gameState.birdY >= floorY - birdSize;                   
+                // if (hitFloor)
+                //     printlog(1, "hit floor :(");
+
+                /**
+                 * handle collisions
+                 */
+                if (hitPipe || hitFloor)
+                {
+                    gameState.running = RunningT::Dead;
+
+                    if (hitPipe)
+                        gameState.birdVY = jumpForce;
+                    reanchor(gameState);
+                }
+                
+                /**
+                 * update score
+                 */
+                for (int k = gameState.pipeHead; k < gameState.nextPipe; k++)
+                {
+                    auto& pipe = gameState.pipe(k);
+                    if (birdX + gameState.xOffset + speed * dt <= pipe.x)
+                        break;
+
+                    bool scored = (
+                        birdX + gameState.xOffset <= pipe.x &&
+                        birdX + gameState.xOffset + speed * dt > pipe.x
+                    );
+                    if (scored)
+                    {
+                        gameState.score += 1;
+                        // printlog(0, "score!: %d", gameState.score);
+                    }
+                }
+
+            }
+            break;
+        case RunningT::Dead:
+            {
+                if (anchored)
+                    advance_anchor(gameState, false);
+                else
+                    update_bird();
+
+                // if bird is at floor, move to restart
+                if (gameState.birdY >= floorY - birdSize)
+                    gameState.running = RunningT::Restart;
+            }
+            break;
+        case RunningT::Restart:
+            {
+                if (flap)
+                {
+                    gameState = GameState(Level::nextSeed(gameState.seed), gameState.numPipes);
+                }
+            }
+            break;
+    }
+}
+
+
+/**
+ * Swept integration
+ * -----------------
+ * The bird follows the parabola through the positions discrete ticks of
+ * `tickTime` produce (semi-implicit Euler adds `gravity * tickTime / 2` of
+ * velocity per tick), so coarse steps stay on the tick-by-tick trajectory.
+ * The parabola is cut into chords of at most `SWEEP_SEGMENT` seconds (< 0.2px
+ * off the curve), each swept against the pipes and the floor.
+ */
+static const float SWEEP_SEGMENT = 2 * tickTime;
+
+// bird free fall over `dt`, clamped to floor / ceiling
+static inline void fall(float& y, float& vy, float dt)
+{
+    y += (vy + 0.5f * gravity * tickTime) * dt + 0.5f * gravity * dt * dt;
+    vy += gravity * dt;
+    y = Math::clamp(y, birdSize, floorY - birdSize);
+}
+
+static void step_swept(GameState& gameState, bool flap, float dt)
+{
+    const float floorLimit = floorY - birdSize;
+
+    switch (gameState.running)
+    {
+        case RunningT::Running:
+            {
+                if (flap)
+                    gameState.birdVY = jumpForce;
+
+                int numSegments = Math::max(1, (int)ceilf(dt / SWEEP_SEGMENT));
+                float segment = dt / numSegments;
+                float dx = speed * segment;
+                float elapsed = 0;
+                bool hitPipe = false;
+                bool hitFloor = false;
+
+                for (int s = 0; s < numSegments && !(hitPipe || hitFloor); s++)
+                {
+                    float x0 = gameState.xOffset;
+                    float y0 = gameState.birdY;
+                    float vy0 = gameState.birdVY;
+                    float y1 = y0;
+                    float vy1 = vy0;
+                    fall(y1, vy1, segment);
+                    float dy = y1 - y0;
+
+                    /**
+                     * earliest impact along the chord; the bird moves right
+                     * by `dx` relative to the pipes
+                     */
+                    float toi = Collision::NO_HIT;
+                    for (int k = gameState.pipeHead; k < gameState.nextPipe; k++)
+                    {
+                        auto& pipe = gameState.pipe(k);
+                        auto xPos = pipe.x - x0;
+                        if (xPos >= birdX + birdSize + dx)
+                            break;
+
+                        float top = Collision::sweptCircleRect(
+                            birdX, y0, dx, dy, birdSize,
+                            xPos, 0, pipeWidth, pipe.y - halfGap
+                        );
+                        float btm = Collision::sweptCircleRect(
+                            birdX, y0, dx, dy, birdSize,
+                            xPos, pipe.y + halfGap, pipeWidth, floorY
+                        );
+                        toi = Math::min(toi, Math::min(top, btm));
+                    }
+                    hitPipe = toi <= 1;
+
+                    if (y1 >= floorLimit)
+                    {
+                        float floorToi = y0 >= floorLimit ? 0 : (floorLimit - y0) / dy;
+                        if (floorToi < toi)
+                        {
+                            toi = floorToi;
+                            hitPipe = false;
+                            hitFloor = true;
+                        }
+                    }
+
+                    /**
+                     * advance to the impact (or the end of the chord)
+                     */
+                    if (hitPipe || hitFloor)
+                    {
+                        gameState.xOffset = x0 + dx * toi;
+                        gameState.birdY = y0 + dy * toi;
+                        gameState.birdVY = vy0 + (vy1 - vy0) * toi;
+                        elapsed += segment * toi;
+                    }
+                    else
+                    {
+                        gameState.xOffset = x0 + dx;
+                        gameState.birdY = y1;
+                        gameState.birdVY = vy1;
+                        elapsed += segment;
+                    }
+
+                    /**
+                     * score: a pipe counts once its x is in
+                     * [birdX + xOffset, + speed * tickTime) after a tick, so
+                     * consecutive steps score [x0, xOffset) shifted by that
+                     */
+                    float scoreFrom = birdX + x0 + speed * tickTime;
+                    float scoreTo = birdX + gameState.xOffset + speed * tickTime;
+                    for (int k = gameState.pipeHead; k < gameState.nextPipe; k++)
+                    {
+                        auto& pipe = gameState.pipe(k);
+                        if (pipe.x >= scoreTo)
+                            break;
+                        if (pipe.x >= scoreFrom)
+                            gameState.score += 1;
+                    }
+
+                    // recycle (keeps the ring ahead of long steps)
+                    while (gameState.pipe(gameState.pipeHead).x - gameState.xOffset + pipeWidth <= 0.0)
+                    {
+                        gameState.pipeHead++;
+                        gameState.pipe(gameState.nextPipe) = Level::pipe(gameState.seed, gameState.nextPipe);
+                        gameState.nextPipe++;
+                    }
+                }
+
+                if (hitPipe || hitFloor)
+                {
+                    gameState.running = RunningT::Dead;
+                    if (hitPipe)
+                        gameState.birdVY = jumpForce;
+
+                    // rest of the step is spent falling
+                    float rest = dt - elapsed;
+                    if (rest > 0 && hitPipe)
+                    {
+                        fall(gameState.birdY, gameState.birdVY, rest);
+                        if (gameState.birdY >= floorLimit)
+                            gameState.running = RunningT::Restart;
+                    }
+                }
+            }
+            break;
+        case RunningT::Dead:
+            {
+                fall(gameState.birdY, gameState.birdVY, dt);
+                if (gameState.birdY >= floorLimit)
+                    gameState.running = RunningT::Restart;
+            }
+            break;
+        case RunningT::Restart:
+            {
+                if (flap)
+                {
+                    gameState = GameState(Level::nextSeed(gameState.seed), gameState.numPipes);
+                }
+            }
+            break;
+    }
+}
+
+
+void Sim::step(GameState& gameState, bool flap)
+{
+    step_discrete(gameState, flap, tickTime, true);
+}
+
+void Sim::stepDt(GameState& gameState, bool flap, float dt, Integration integration)
+{
+    if (integration == Integration::Swept)
+        step_swept(gameState, flap, dt);
+    else
+        step_discrete(gameState, flap, dt, false);
+
+    // off the tick grid: later `step()`s continue from here
+    reanchor(gameState);
+}
+
+
+/**
+ * Fast-forward
+ * ------------
+ * Finds the next anchored tick at which something may happen without
+ * input: the bird nearing the floor / ceiling, the head pipe being
+ * recycled, the bird entering a pipe's x-window, or, inside it, leaving the
+ * gap band or reaching the scoring tick. Event times are solved in closed
+ * form with a pixel of margin and rounded down, so a jump never skips one;
+ * the event tick itself is a regular `step()`.
+ */
+static const double EVENT_MARGIN = 1.0; // px
+
+// bird height as a quadratic in anchored ticks: y(m) = a*m^2 + b*m + c
+struct Parabola
+{
+    double a, b, c;
+
+    // first tick after `m0` at which y(m) may leave [lo, hi] (y(m0) is in it)
+    double leaves(double m0, double lo, double hi) const
+    {
+        double event = 1e18;
+
+        // below `hi` between the roots of y = hi: leaves at the upper one
+        double disc = this->b * this->b - 4 * this->a * (this->c - hi);
+        if (disc >= 0)
+            event = floor((-this->b + sqrt(disc)) / (2 * this->a));
+
+        // above `lo` only between the roots of y = lo
+        disc = this->b * this->b - 4 * this->a * (this->c - lo);
+        if (disc > 0)
+        {
+            double r1 = (-this->b - sqrt(disc)) / (2 * this->a);
+            if (r1 > m0)
+                event = std::min(event, floor(r1));
+        }
+        return event;
+    }
+};
+
+// anchored tick of the next event (> `gameState.anchorTicks` means a jump
+// is possible)
+static double next_event(const GameState& gameState)
+{
+    const double m0 = gameState.anchorTicks;
+    const double now = m0 + 1;
+
+    float x, y, vy;
+    at_anchor(gameState, gameState.anchorTicks, x, y, vy);
+
+    Parabola bird;
+    bird.a = 0.5 * (double)GRAVITY_Y;
+    bird.b = (double)gameState.anchorVY * tickTime + 0.5 * (double)GRAVITY_Y;
+    bird.c = gameState.anchorY;
+
+    /**
+     * floor / ceiling
+     */
+    double lo = birdSize + EVENT_MARGIN;
+    double hi = floorY - birdSize - EVENT_MARGIN;
+    if (y <= lo || y >= hi)
+        return now;
+    double event = bird.leaves(m0, lo, hi);
+
+    if (gameState.running != RunningT::Running)
+        return event;
+
+    /**
+     * pipes; x(m) = anchorX + m * SCROLL
+     */
+    auto crossing = [&](double xLine) -> double
+    {
+        return floor((xLine - gameState.anchorX) / SCROLL);
+    };
+
+    // head pipe recycled
+    auto& head = gameState.pipe(gameState.pipeHead);
+    event = std::min(event, crossing(head.x + pipeWidth - EVENT_MARGIN));
+
+    // x-window: circle vs pipe x-overlap; it contains the scoring tick
+    for (int k = gameState.pipeHead; k < gameState.nextPipe; k++)
+    {
+        auto& pipe = gameState.pipe(k);
+        double windowStart = pipe.x - birdX - birdSize - EVENT_MARGIN;
+        double windowEnd = pipe.x + pipeWidth - birdX + birdSize + EVENT_MARGIN;
+        if (x >= windowEnd)
+            continue;
+
+        if (x < windowStart)
+        {
+            event = std::min(event, crossing(windowStart));
+            break;
+        }
+
+        // inside: safe while the circle stays within the gap band
+        double gapLo = pipe.y - halfGap + birdSize + EVENT_MARGIN;
+        double gapHi = pipe.y + halfGap - birdSize - EVENT_MARGIN;
+        if (y <= gapLo || y >= gapHi)
+            return now;
+        event = std::min(event, bird.leaves(m0, gapLo, gapHi));
+
+        // scoring tick: `birdX + xOffset` within `SCROLL` of `pipe.x`
+        double scoreLine = pipe.x - birdX;
+        if (x <= scoreLine + EVENT_MARGIN)
+            event = std::min(event, crossing(scoreLine - SCROLL - EVENT_MARGIN));
+    }
+
+    return event;
+}
+
+int Sim::fastForward(GameState& gameState, int maxTicks)
+{
+    if (maxTicks <= 0)
+        return 0;
+
+    // nothing moves until the restart input
+    if (gameState.running == RunningT::Restart)
+        return maxTicks;
+
+    int m0 = gameState.anchorTicks;
+    double target = std::min(next_event(gameState) - 1, (double)m0 + maxTicks);
+    if (target < m0 + 1)
+    {
+        Sim::step(gameState, false);
+        return 1;
+    }
+
+    // nothing happens in between: evaluate the closed form directly
+    gameState.anchorTicks = (int)target;
+
+    float x, y, vy;
+    at_anchor(gameState, gameState.anchorTicks, x, y, vy);
+    if (gameState.running == RunningT::Running)
+        gameState.xOffset = x;
+    gameState.birdY = y;
+    gameState.birdVY = vy;
+
+    return gameState.anchorTicks - m0;
+}
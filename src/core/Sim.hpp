@@ -0,0 +1,33 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Sim.hpp
+ * - headless game simulation (physics, pipe generation, collision)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+
+enum class Integration {
+    Discrete,   // move, then test overlaps at the end (what `step()` does)
+    Swept,      // continuous: first time of impact along the path
+};
+
+class Sim
+{
+public:
+    // advance `gameState` by one tick (`DELTA_TIME`); `flap` is the
+    // jump / restart input for this tick
+    static void step(GameState& gameState, bool flap);
+
+    // advance by an arbitrary `dt` (e.g. several ticks at once); `flap`
+    // applies at the start. `Discrete` tunnels through pipes once a step
+    // moves further than a pipe is wide, `Swept` doesn't.
+    static void stepDt(GameState& gameState, bool flap, float dt, Integration integration = Integration::Swept);
+
+    // advance up to `maxTicks` ticks without input, in one jump when nothing
+    // happens on the way; returns the ticks advanced (>= 1). Same result as
+    // that many `step(gameState, false)` calls, bit for bit.
+    static int fastForward(GameState& gameState, int maxTicks);
+};
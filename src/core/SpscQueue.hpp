@@ -0,0 +1,72 @@
+/**
+ * -----------------------------------------------------------------------------
+ * SpscQueue.hpp
+ * - wait-free single producer / single consumer FIFO of `N` (power of two)
+ *   values: a fixed ring, no allocation, no locks. `push()` on a full queue
+ *   fails right away instead of waiting for the consumer.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "core/core.hpp"
+
+
+template <typename T, int N>
+class SpscQueue
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() : mHead(0), mTail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * producer side
+     */
+    // false if full (`value` is dropped)
+    bool push(const T& value)
+    {
+        uint32_t tail = this->mTail.load(std::memory_order_relaxed);
+        if (tail - this->mHeadCache >= (uint32_t)N)
+        {
+            this->mHeadCache = this->mHead.load(std::memory_order_acquire);
+            if (tail - this->mHeadCache >= (uint32_t)N)
+                return false;
+        }
+        this->mSlots[tail & (N - 1)] = value;
+        this->mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * consumer side
+     */
+    // false if empty
+    bool pop(T& value)
+    {
+        uint32_t head = this->mHead.load(std::memory_order_relaxed);
+        if (head == this->mTailCache)
+        {
+            this->mTailCache = this->mTail.load(std::memory_order_acquire);
+            if (head == this->mTailCache)
+                return false;
+        }
+        value = this->mSlots[head & (N - 1)];
+        this->mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T mSlots[N];
+
+    // each side's index + its last look at the other's, on its own line
+    alignas(CACHE_LINE) std::atomic<uint32_t> mHead;   // consumer
+    uint32_t mTailCache = 0;
+    alignas(CACHE_LINE) std::atomic<uint32_t> mTail;   // producer
+    uint32_t mHeadCache = 0;
+};
@@ -0,0 +1,71 @@
+/**
+ * -----------------------------------------------------------------------------
+ * TripleBuffer.hpp
+ * - lock-free single producer / single consumer hand-off of the latest value:
+ *   the writer fills its own back slot and publishes it, the reader picks up
+ *   the newest published slot whenever it wants. Neither side ever waits for
+ *   the other; values the reader was too slow for are simply skipped.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <atomic>
+
+#include "core/core.hpp"
+
+
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : mMiddle(1) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * writer side
+     */
+    // slot being written; not visible to the reader until `publish()`
+    T& back() { return this->mSlots[this->mBack].value; }
+
+    // hand `back()` to the reader; the writer continues in a free slot
+    // (NOTE: its contents are stale, overwrite everything that matters)
+    void publish()
+    {
+        int prev = this->mMiddle.exchange(this->mBack | FRESH, std::memory_order_acq_rel);
+        this->mBack = prev & INDEX;
+    }
+
+    /**
+     * reader side
+     */
+    // switch `front()` to the newest published value; false if there was
+    // nothing new since the last call
+    bool fetch()
+    {
+        if (!(this->mMiddle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        int prev = this->mMiddle.exchange(this->mFront, std::memory_order_acq_rel);
+        this->mFront = prev & INDEX;
+        return true;
+    }
+
+    // value last fetched (a default `T` before the first publish)
+    const T& front() const { return this->mSlots[this->mFront].value; }
+
+private:
+    static const int INDEX = 3;
+    static const int FRESH = 4; // middle slot was published, not yet fetched
+
+    // padded so the two sides never write to the same cache line
+    struct alignas(CACHE_LINE) Slot
+    {
+        T value;
+    };
+
+    Slot mSlots[3];
+    alignas(CACHE_LINE) std::atomic<int> mMiddle; // slot index | FRESH
+    alignas(CACHE_LINE) int mBack = 0;            // writer only
+    alignas(CACHE_LINE) int mFront = 2;           // reader only
+};
@@ -0,0 +1,100 @@
+/**
+ * -----------------------------------------------------------------------------
+ * core.hpp
+ * - shared base for the simulation core; MUST NOT include raylib so that
+ *   `flappy_core` can be built and run without a window / GL context.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef CORE_H
+#define CORE_H
+
+
+/**
+ * Global Macros
+ */
+#define DEBUG				true
+#define DRAW_STATS          false
+#define SCREEN_H            600 //640 
+#define SCREEN_W            400
+
+#define FPS					60  // assumes 60fps
+#define DELTA_TIME			(1.0 / FPS)
+
+#define CACHE_LINE          64  // bytes
+
+
+/**
+ * External / 3rd Party Imports
+ */
+// C std
+#include <stdlib.h> // Required for: malloc(), free(), rand()
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string.h>
+
+// Utility
+#include "util/package.hpp"
+
+// counter-based rng (`rng::`)
+#include "core/Rng.hpp"
+
+
+/**
+ * MISC
+ * --------------
+ */
+
+
+
+/**
+ * for errors...
+ */
+inline void die(const char *message)
+{
+    perror(message);
+    exit(1); 
+}
+
+/**
+ * `println()` for easier logging...
+ */
+inline void println(const char *text, ...)
+{
+	va_list argp;
+	
+	va_start(argp, text);
+	vfprintf(stdout, text, argp);
+	va_end(argp);
+
+	fputc('\n', stdout);
+}
+
+/**
+ * trace logging
+ */
+inline void printlog(int msgType, const char *text, ...)
+{
+    va_list args;
+    va_start(args, text);
+
+    switch (msgType)
+    {
+        case 0: fprintf(stdout, "[ INFO ]: "); break;
+        case 1: fprintf(stdout, "[ DEBUG ]: "); break;
+        case 2: fprintf(stdout, "[ ERROR ]: "); break;
+        case 3: fprintf(stdout, "[ WARNING ]: "); break;
+        default: assert(false); break;
+    }
+
+    vfprintf(stdout, text, args);
+    fprintf(stdout, "\n");
+
+    va_end(args);
+
+    if (msgType == 3) exit(1);
+}
+
+
+
+#endif /* CORE_H */
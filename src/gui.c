@@ -27,7 +27,7 @@ void gui_sayHello()
     printf("hello, world [gui.c]\n");
 }
 
-void gui_label(Rectangle r, char *text)
+void gui_label(Rectangle r, const char *text)
 {
     GuiLabel(r, text);
 }
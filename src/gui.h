@@ -20,7 +20,7 @@ extern "C"
 
 // C header here
 void gui_sayHello(); // test fn
-void gui_label(Rectangle r, char *text);
+void gui_label(Rectangle r, const char *text);
 bool gui_toggleButton(Rectangle r, char *text, bool value);
 int gui_measureText(char *text);
 float gui_sliderBar(Rectangle bounds, float value, float minValue, float maxValue);
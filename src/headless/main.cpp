@@ -0,0 +1,1218 @@
+/**
+ * -----------------------------------------------------------------------------
+ * headless/main.cpp
+ * - runs the simulation core without a window (no raylib) and reports
+ *   throughput; links against `flappy_core` only
+ *
+ * usage:
+ *   headless [sim] [ticks]             single `GameState` via `Sim::step()`
+ *   headless batch [envs] [ticks]      `BatchedGameState` via `BatchSim::step()`
+ *   headless verify [envs] [ticks]     check batch lanes against `Sim::step()`
+ *   headless clone [clones] [ticks]    snapshot restore + step throughput
+ *   headless plan [ticks] [budgetUs] [threads]
+ *                                      play with the `Planner` as autopilot
+ *   headless threads [envs] [ticks] [maxThreads]
+ *                                      `Rollout` scaling from 1 to N threads
+ *   headless replay [ticks] [path]     record, save, reload and check playback
+ *                                      + keyframe seeks against the live run
+ *   headless collide [count] [reps]    `Collision` kernels: SIMD vs scalar
+ *   headless swept [games] [stepTicks] coarse `Sim::stepDt()` (swept / discrete)
+ *                                      vs tick-by-tick outcomes
+ *   headless ffwd [games] [ticks]      event-driven `Sim::fastForward()` vs
+ *                                      tick-by-tick (bit-exact check)
+ *   headless level [lookups] [threads] shared `LevelStream`: random access
+ *                                      from N threads vs `Level::pipe()`,
+ *                                      then rebuilt from the free list after
+ *                                      `reset()` (must not allocate)
+ *   headless alloc [frames] [warmup]   the app's per-frame core work (and a
+ *                                      threaded planner) must not allocate
+ *                                      after warm-up (debug builds)
+ *   headless triple [publishes]        `TripleBuffer` sim -> render hand-off
+ *                                      between two threads (torn / stale reads)
+ *   headless profile [ticks] [path]    `PROFILE_SCOPE` overhead + a Chrome
+ *                                      trace of a profiled sim / planner run
+ *   headless pack [path] [opens]       `AssetPack` open + read of every pixel
+ *                                      page (what the app does before upload);
+ *                                      "embedded" (the default with
+ *                                      EMBED_ASSETS) uses the built-in pack
+ *   headless audio [ticks] [path]      SPSC queue stress test, sounds of an
+ *                                      autopilot run mixed offline into a WAV,
+ *                                      then the mixer thread in real time
+ *                                      (`play()` -> output latency, at our
+ *                                      period and at raylib's)
+ * -----------------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "core/core.hpp"
+#include "core/GameState.hpp"
+#include "core/Sim.hpp"
+#include "core/Batch.hpp"
+#include "core/JobPool.hpp"
+#include "core/Rollout.hpp"
+#include "core/Planner.hpp"
+#include "core/Replay.hpp"
+#include "core/LevelStream.hpp"
+#include "core/AllocCounter.hpp"
+#include "core/TripleBuffer.hpp"
+#include "core/Profiler.hpp"
+#include "core/AssetPack.hpp"
+#include "core/Audio.hpp"
+#include "core/HudText.hpp"
+#include "util/Collision.hpp"
+
+
+/**
+ * simple scripted policy so the bird actually plays through pipes:
+ * flap whenever it drops below the gap of the next pipe
+ */
+static bool autopilot(
+    RunningT running, float birdY, float birdVY, float xOffset,
+    const float *pipeX, const float *pipeY, int numPipes
+) {
+    if (running != RunningT::Running)
+        return true; // restart asap
+
+    float targetY = floorY / 2;
+    float nextX = 0;
+    for (int p = 0; p < numPipes; p++)
+    {
+        float xPos = pipeX[p] - xOffset + pipeWidth;
+        if (xPos >= birdX - birdSize && (nextX == 0 || pipeX[p] < nextX))
+        {
+            nextX = pipeX[p];
+            targetY = pipeY[p] + halfGap / 2;
+        }
+    }
+
+    return birdY > targetY && birdVY > 0;
+}
+
+static bool autopilot(const GameState& gameState)
+{
+    float pipeX[BATCH_PIPES];
+    float pipeY[BATCH_PIPES];
+    for (int p = 0; p < BATCH_PIPES; p++)
+    {
+        auto& pipe = gameState.pipe(gameState.pipeHead + p);
+        pipeX[p] = pipe.x;
+        pipeY[p] = pipe.y;
+    }
+
+    return autopilot(
+        gameState.running, gameState.birdY, gameState.birdVY, gameState.xOffset,
+        pipeX, pipeY, BATCH_PIPES
+    );
+}
+
+static void autopilot_lanes(const BatchedGameState& batch, int begin, int end, uint8_t *flap)
+{
+    for (int i = begin; i < end; i++)
+    {
+        float pipeX[BATCH_PIPES];
+        float pipeY[BATCH_PIPES];
+        for (int p = 0; p < BATCH_PIPES; p++)
+        {
+            pipeX[p] = batch.pipeX[p][i];
+            pipeY[p] = batch.pipeY[p][i];
+        }
+        flap[i] = autopilot(
+            (RunningT)batch.running[i], batch.birdY[i], batch.birdVY[i], batch.xOffset[i],
+            pipeX, pipeY, BATCH_PIPES
+        );
+    }
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+
+/**
+ * Modes
+ * -----
+ */
+static int run_sim(long ticks)
+{
+    GameState gameState;
+    int bestScore = 0;
+    int runs = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long i = 0; i < ticks; i++)
+    {
+        bool flap = autopilot(gameState);
+        if (flap && gameState.running == RunningT::Restart)
+        {
+            bestScore = gameState.score > bestScore ? gameState.score : bestScore;
+            runs += 1;
+        }
+        Sim::step(gameState, flap);
+    }
+
+    double secs = seconds_since(start);
+
+    printlog(0, "[sim] ticks: %ld | runs: %d | best score: %d", ticks, runs, bestScore);
+    printlog(0, "[sim] %.3f s | %.2f M ticks/s", secs, ticks / secs / 1e6);
+
+    return 0;
+}
+
+static int run_batch(int envs, long ticks)
+{
+    BatchedGameState batch(envs);
+    std::vector<uint8_t> flap(envs, 0);
+    long episodes = 0;
+    int bestScore = 0;
+    double stepSecs = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long t = 0; t < ticks; t++)
+    {
+        autopilot_lanes(batch, 0, envs, flap.data());
+
+        auto stepStart = std::chrono::steady_clock::now();
+        BatchSim::step(batch, flap.data());
+        stepSecs += seconds_since(stepStart);
+
+        for (int i = 0; i < envs; i++)
+        {
+            if (batch.done[i])
+            {
+                episodes++;
+                if (batch.episodeScore[i] > bestScore)
+                    bestScore = batch.episodeScore[i];
+            }
+        }
+    }
+
+    double secs = seconds_since(start);
+    double steps = (double)envs * ticks;
+
+    printlog(0, "[batch] envs: %d | ticks: %ld | episodes: %ld | best score: %d", envs, ticks, episodes, bestScore);
+    printlog(0, "[batch] %.3f s | %.2f M env-steps/s (incl. policy)", secs, steps / secs / 1e6);
+    printlog(0, "[batch] %.3f s | %.2f M env-steps/s (step kernel only)", stepSecs, steps / stepSecs / 1e6);
+
+    return 0;
+}
+
+
+static int run_verify(int envs, long ticks)
+{
+    BatchedGameState batch(envs);
+    batch.autoReset = false; // restart through the flap input like `Sim`
+
+    AlignedArray<GameState> games(envs);
+    for (int i = 0; i < envs; i++)
+        games[i] = GameState(rng::DEFAULT_SEED + i);
+
+    std::vector<uint8_t> flap(envs, 0);
+    int mismatches = 0;
+
+    for (long t = 0; t < ticks && mismatches == 0; t++)
+    {
+        for (int i = 0; i < envs; i++)
+        {
+            flap[i] = autopilot(games[i]);
+            Sim::step(games[i], flap[i]);
+        }
+
+        BatchSim::step(batch, flap.data());
+
+        for (int i = 0; i < envs; i++)
+        {
+            GameState lane;
+            batch.store(i, lane);
+
+            bool same = lane == games[i];
+            if (!same)
+            {
+                printlog(2, "[verify] env %d differs at tick %ld", i, t);
+                mismatches++;
+            }
+        }
+    }
+
+    printlog(0, "[verify] envs: %d | ticks: %ld | mismatches: %d", envs, ticks, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+static int run_clone(long clones, int ticks)
+{
+    // fork from a mid-game state, like a planner would
+    GameState root;
+    for (int i = 0; i < 300; i++)
+        Sim::step(root, autopilot(root));
+
+    GameSnapshot snapshot;
+    snapshot.save(root);
+
+    // raw save + restore cost
+    GameState scratch;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < clones; i++)
+    {
+        snapshot.save(root);
+        snapshot.restore(scratch);
+        asm volatile("" : : "r"(&scratch) : "memory"); // keep the copies
+    }
+    double copySecs = seconds_since(start);
+
+    // clone + step `ticks` ticks
+    long alive = 0;
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < clones; i++)
+    {
+        snapshot.restore(scratch);
+        for (int t = 0; t < ticks; t++)
+            Sim::step(scratch, ((i >> (t % 8)) & 1) != 0);
+        alive += scratch.running == RunningT::Running;
+    }
+    double stepSecs = seconds_since(start);
+
+    printlog(0, "[clone] sizeof(GameState): %d | save + restore: %.2f ns",
+        (int)sizeof(GameState), copySecs / clones * 1e9);
+    printlog(0, "[clone] clone + %d ticks: %.2f M clones/s | %.2f M ticks/s | alive: %ld",
+        ticks, clones / stepSecs / 1e6, (double)clones * ticks / stepSecs / 1e6, alive);
+
+    return 0;
+}
+
+static int run_plan(long ticks, int budgetMicros, int threads)
+{
+    PlannerConfig config;
+    config.threads = threads;
+    Planner planner(config);
+
+    GameState gameState;
+    int deaths = 0;
+    int bestScore = 0;
+    long planned = 0;
+    long totalMicros = 0;
+    int maxMicros = 0;
+
+    for (long i = 0; i < ticks; i++)
+    {
+        bool wasRunning = gameState.running == RunningT::Running;
+
+        PlanResult plan = planner.plan(gameState, budgetMicros);
+        if (wasRunning)
+        {
+            planned++;
+            totalMicros += plan.micros;
+            maxMicros = plan.micros > maxMicros ? plan.micros : maxMicros;
+        }
+
+        Sim::step(gameState, plan.flap);
+
+        bestScore = gameState.score > bestScore ? gameState.score : bestScore;
+        if (wasRunning && gameState.running != RunningT::Running)
+            deaths++;
+    }
+
+    printlog(0, "[plan] ticks: %ld | deaths: %d | best score: %d", ticks, deaths, bestScore);
+    printlog(0, "[plan] budget: %d us | avg: %.1f us | max: %d us",
+        budgetMicros, planned ? (double)totalMicros / planned : 0.0, maxMicros);
+
+    return 0;
+}
+
+static int run_threads(int envs, long ticks, int maxThreads)
+{
+    if (maxThreads <= 0)
+        maxThreads = (int)std::thread::hardware_concurrency();
+    maxThreads = maxThreads > 0 ? maxThreads : 1;
+
+    double baseRate = 0;
+
+    for (int threads = 1; ; threads = Math::min(threads * 2, maxThreads))
+    {
+        JobPool pool(threads);
+        BatchedGameState batch(envs);
+        std::vector<uint8_t> flap(batch.capacity, 0);
+
+        auto start = std::chrono::steady_clock::now();
+        Rollout::stepTicks(pool, batch, flap.data(), ticks, autopilot_lanes);
+        double secs = seconds_since(start);
+
+        uint64_t steps = 0;
+        uint64_t steals = 0;
+        for (int w = 0; w < pool.numThreads(); w++)
+        {
+            steps += pool.stats(w).steps;
+            steals += pool.stats(w).steals;
+        }
+
+        double rate = steps / secs;
+        if (threads == 1)
+            baseRate = rate;
+
+        printlog(0, "[threads] %3d threads | %8.2f M env-steps/s | x%5.2f | steals: %llu",
+            threads, rate / 1e6, rate / baseRate, (unsigned long long)steals);
+
+        if (threads == maxThreads)
+            break;
+    }
+
+    return 0;
+}
+
+static int run_replay(long ticks, const char *path)
+{
+    // live session: a jittery autopilot so the input stream isn't trivial
+    GameState gameState;
+    ReplayRecorder recorder;
+    recorder.begin(gameState, 600, (int)std::max<long>(ticks, REPLAY_MAX_TICKS));
+
+    AlignedArray<GameState> live(ticks + 1);
+    for (long t = 0; t < ticks; t++)
+    {
+        live[t] = gameState;
+        bool flap = autopilot(gameState) && rng::hash(1, (uint32_t)t) % 8 != 0;
+        recorder.record(gameState, flap);
+        Sim::step(gameState, flap);
+    }
+    live[ticks] = gameState;
+
+    auto& header = recorder.replay.header;
+    if (!recorder.replay.save(path))
+        return 1;
+
+    Replay replay;
+    if (!replay.load(path))
+        return 1;
+
+    printlog(0, "[replay] ticks: %u | flaps: %u | keyframes: %u | input: %u bytes (%.3f bits/tick)",
+        header.tickCount, header.flapCount, header.numKeyframes, header.inputBytes,
+        header.inputBytes * 8.0 / header.tickCount);
+
+    // straight playback, uncapped
+    ReplayPlayer player;
+    player.begin(&replay);
+
+    auto start = std::chrono::steady_clock::now();
+    while (player.step()) { }
+    double secs = seconds_since(start);
+
+    int mismatches = 0;
+    if (player.gameState != live[ticks])
+    {
+        printlog(2, "[replay] playback diverged from the live run");
+        mismatches++;
+    }
+    printlog(0, "[replay] playback: %.3f s | %.2f M ticks/s", secs, ticks / secs / 1e6);
+
+    // random seeks, back and forth
+    const int seeks = 1000;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < seeks; i++)
+    {
+        long target = rng::hash(2, (uint32_t)i) % (ticks + 1);
+        player.seek((int)target);
+        if (player.gameState != live[target])
+        {
+            printlog(2, "[replay] seek to tick %ld differs", target);
+            mismatches++;
+        }
+    }
+    secs = seconds_since(start);
+
+    printlog(0, "[replay] seeks: %d | %.1f us/seek | mismatches: %d", seeks, secs / seeks * 1e6, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+static int run_collide(int count, int reps)
+{
+    // rects scattered around the circles so a fair share of the tests hit
+    AlignedArray<float> rx(count), ry(count), rw(count), rh(count);
+    AlignedArray<float> cx(count), cy(count);
+    for (int i = 0; i < count; i++)
+    {
+        rx[i] = rng::range(3, 4 * i + 0, -60, 60);
+        ry[i] = rng::range(3, 4 * i + 1, -60, 60);
+        rw[i] = rng::range(3, 4 * i + 2, 10, 50);
+        rh[i] = rng::range(3, 4 * i + 3, 10, 50);
+        cx[i] = rng::range(4, 2 * i + 0, -40, 60);
+        cy[i] = rng::range(4, 2 * i + 1, -40, 60);
+    }
+
+    std::vector<uint8_t> hitsSimd(count), hitsScalar(count);
+    int mismatches = 0;
+
+    auto bench = [&](const char *name, std::vector<uint8_t>& hits, int (*fn)(int, uint8_t *))
+    {
+        long numHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++)
+            numHits += fn(r, hits.data());
+        double secs = seconds_since(start);
+        printlog(0, "[collide] %-22s %7.1f M tests/s (hit rate: %.2f)",
+            name, (double)count * reps / secs / 1e6, (double)numHits / count / reps);
+    };
+
+    // captureless lambdas -> function pointers, so the loops can't be fused
+    static const float *sRx, *sRy, *sRw, *sRh, *sCx, *sCy;
+    static int sCount;
+    sRx = rx.data(); sRy = ry.data(); sRw = rw.data(); sRh = rh.data();
+    sCx = cx.data(); sCy = cy.data(); sCount = count;
+
+    bench("simd   circleVsRects", hitsSimd, [](int r, uint8_t *hits) {
+        return Collision::circleVsRects(sCx[r % sCount], sCy[r % sCount], birdSize, sRx, sRy, sRw, sRh, sCount, hits);
+    });
+    bench("scalar circleVsRects", hitsScalar, [](int r, uint8_t *hits) {
+        return Collision::circleVsRectsScalar(sCx[r % sCount], sCy[r % sCount], birdSize, sRx, sRy, sRw, sRh, sCount, hits);
+    });
+    mismatches += hitsSimd != hitsScalar;
+
+    bench("simd   circlesVsRect", hitsSimd, [](int r, uint8_t *hits) {
+        return Collision::circlesVsRect(sCx, sCy, birdSize, sRx[r % sCount], sRy[r % sCount], sRw[r % sCount], sRh[r % sCount], sCount, hits);
+    });
+    bench("scalar circlesVsRect", hitsScalar, [](int r, uint8_t *hits) {
+        return Collision::circlesVsRectScalar(sCx, sCy, birdSize, sRx[r % sCount], sRy[r % sCount], sRw[r % sCount], sRh[r % sCount], sCount, hits);
+    });
+    mismatches += hitsSimd != hitsScalar;
+
+    printlog(0, "[collide] count: %d | reps: %d | lanes: %d | mismatches: %d", count, reps, simd::LANES, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+static int run_swept(int games, int stepTicks)
+{
+    const int maxTicks = 60 * 60;
+    const float dt = stepTicks * tickTime;
+
+    struct Outcome { int score; int deathTick; };
+
+    // autopilot decides every `stepTicks` ticks in all three runs
+    auto play = [&](uint64_t seed, int mode) -> Outcome
+    {
+        GameState gameState(seed);
+        for (int t = 0; t < maxTicks; t += stepTicks)
+        {
+            bool flap = gameState.running == RunningT::Running && autopilot(gameState);
+            if (mode == 0)
+            {
+                for (int i = 0; i < stepTicks && gameState.running == RunningT::Running; i++)
+                {
+                    Sim::step(gameState, flap && i == 0);
+                    if (gameState.running != RunningT::Running)
+                        return Outcome{ gameState.score, t + i };
+                }
+            }
+            else
+            {
+                Sim::stepDt(gameState, flap, dt, mode == 1 ? Integration::Swept : Integration::Discrete);
+                if (gameState.running != RunningT::Running)
+                    return Outcome{ gameState.score, t };
+            }
+        }
+        return Outcome{ gameState.score, maxTicks };
+    };
+
+    const char *names[3] = { "ticks", "swept", "discrete" };
+    std::vector<Outcome> ref(games);
+
+    printlog(0, "[swept] games: %d | step: %d ticks (%.3f s, %.0f px / step)", games, stepTicks, dt, speed * dt);
+    for (int mode = 0; mode < 3; mode++)
+    {
+        int agree = 0, tunnelled = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < games; g++)
+        {
+            Outcome out = play(rng::DEFAULT_SEED + g, mode);
+            if (mode == 0)
+                ref[g] = out;
+
+            // same pipes passed, death within one step of the reference
+            agree += out.score == ref[g].score && abs(out.deathTick - ref[g].deathTick) <= stepTicks;
+            tunnelled += out.score > ref[g].score;
+        }
+        double secs = seconds_since(start);
+
+        printlog(0, "[swept] %-8s: %.3f s | agree: %d / %d | outscored ticks (tunnelling): %d",
+            names[mode], secs, agree, games, tunnelled);
+    }
+    return 0;
+}
+
+static int run_ffwd(int games, long ticks)
+{
+    int mismatches = 0;
+    long calls = 0, flaps = 0;
+    double secsTicks = 0, secsEvents = 0;
+
+    std::vector<long> flapTicks;
+    AlignedArray<GameState> atFlap;
+
+    for (int g = 0; g < games; g++)
+    {
+        // reference: tick by tick; records the input schedule + the states
+        // the event-driven run has to reach
+        GameState gameState(rng::DEFAULT_SEED + g);
+        flapTicks.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        for (long t = 0; t < ticks; t++)
+        {
+            bool flap = autopilot(gameState);
+            if (flap)
+                flapTicks.push_back(t);
+            Sim::step(gameState, flap);
+        }
+        secsTicks += seconds_since(start);
+
+        atFlap.resize(flapTicks.size() + 1);
+        {
+            GameState replay(rng::DEFAULT_SEED + g);
+            size_t f = 0;
+            for (long t = 0; t < ticks; t++)
+            {
+                bool flap = f < flapTicks.size() && flapTicks[f] == t;
+                if (flap)
+                    atFlap[f++] = replay;
+                Sim::step(replay, flap);
+            }
+            atFlap[f] = replay;
+        }
+
+        // event driven: jump between flaps
+        GameState events(rng::DEFAULT_SEED + g);
+        start = std::chrono::steady_clock::now();
+        long t = 0;
+        for (size_t f = 0; f <= flapTicks.size(); f++)
+        {
+            long until = f < flapTicks.size() ? flapTicks[f] : ticks;
+            while (t < until)
+            {
+                t += Sim::fastForward(events, (int)(until - t));
+                calls++;
+            }
+
+            if (events != atFlap[f])
+            {
+                printlog(2, "[ffwd] game %d differs at tick %ld", g, t);
+                mismatches++;
+                break;
+            }
+
+            if (f < flapTicks.size())
+            {
+                Sim::step(events, true);
+                t++;
+            }
+        }
+        secsEvents += seconds_since(start);
+        flaps += flapTicks.size();
+    }
+
+    long total = (long)games * ticks;
+    printlog(0, "[ffwd] games: %d | ticks: %ld | flaps: %ld | mismatches: %d", games, ticks, flaps, mismatches);
+    printlog(0, "[ffwd] ticks : %.3f s | %.2f M ticks/s", secsTicks, total / secsTicks / 1e6);
+    printlog(0, "[ffwd] events: %.3f s | %.2f M ticks/s | %.1f ticks / call",
+        secsEvents, total / secsEvents / 1e6, (double)(total - flaps) / calls);
+    return mismatches == 0 ? 0 : 1;
+}
+
+static int run_level(long lookups, int threads)
+{
+    // lookups spread over the cached range and a bit past it
+    const int maxPipe = LEVEL_MAX_CHUNKS * LEVEL_CHUNK_SIZE + LEVEL_CHUNK_SIZE * 16;
+    const int numTasks = 256;
+
+    LevelStream stream(rng::DEFAULT_SEED);
+    JobPool pool(threads);
+    std::atomic<long> mismatches(0);
+    std::atomic<uint64_t> sink(0);
+
+    // every worker reads the same (cold) stream, racing to build chunks
+    auto lookup = [&](bool cached)
+    {
+        auto start = std::chrono::steady_clock::now();
+        pool.run(numTasks, [&](int task, int)
+        {
+            long perTask = lookups / numTasks;
+            float sum = 0;
+            for (long i = 0; i < perTask; i++)
+            {
+                int k = (int)(((long)task * 104729 + i * 7919) % maxPipe); // cheap scatter
+                Vec2f pipe = cached ? stream.pipe(k) : Level::pipe(stream.seed(), k);
+                sum += pipe.y;
+                if (cached && i % 64 == 0 && !(pipe == Level::pipe(stream.seed(), k)))
+                    mismatches++;
+            }
+            sink += (uint64_t)sum;
+        });
+        return seconds_since(start);
+    };
+
+    double cold = lookup(true);
+    int chunks = stream.numChunks();
+    double warm = lookup(true);
+    double direct = lookup(false);
+
+    // next levels: every chunk now comes from the free list, still racing
+    // (lost races return their chunk); with the pool warm too, that must
+    // not allocate at all
+    uint64_t allocsBefore = AllocCounter::count();
+    double reused = 0;
+    int reusedChunks = LEVEL_MAX_CHUNKS;
+    const int levels = 4;
+    for (int i = 0; i < levels; i++)
+    {
+        stream.reset(Level::nextSeed(stream.seed()));
+        reused += lookup(true);
+        reusedChunks = Math::min(reusedChunks, stream.numChunks());
+    }
+    uint64_t reuseAllocs = AllocCounter::count() - allocsBefore;
+
+    printlog(0, "[level] lookups: %ld | threads: %d | chunks built: %d / %d",
+        lookups, pool.numThreads(), chunks, LEVEL_MAX_CHUNKS);
+    printlog(0, "[level] stream (cold): %7.2f M pipes/s", lookups / cold / 1e6);
+    printlog(0, "[level] stream (warm): %7.2f M pipes/s", lookups / warm / 1e6);
+    printlog(0, "[level] stream (reset): %6.2f M pipes/s over %d levels (allocations: %llu%s)",
+        lookups * levels / reused / 1e6, levels, (unsigned long long)reuseAllocs,
+        AllocCounter::enabled() ? "" : ", counter disabled");
+    printlog(0, "[level] Level::pipe  : %7.2f M pipes/s", lookups / direct / 1e6);
+    printlog(0, "[level] mismatches: %ld", mismatches.load());
+    bool ok = mismatches == 0 && chunks == LEVEL_MAX_CHUNKS && reusedChunks == LEVEL_MAX_CHUNKS;
+    return ok && reuseAllocs == 0 ? 0 : 1;
+}
+
+static int run_alloc(long frames, long warmup)
+{
+    if (!AllocCounter::enabled())
+    {
+        printlog(0, "[alloc] allocation counter disabled (not a DEBUG build), skipping");
+        return 0;
+    }
+
+    // what `game_update()` does per tick, minus the window: autopilot,
+    // recording, sim step, pipes in view, and the renderer's score digits
+    // and gui labels (`Hud`, the same calls `Renderer` makes)
+    PlannerConfig config;
+    config.beamWidth = 16;
+    Planner planner(config);
+
+    // and the threaded planner, wide enough that its levels go through the
+    // `JobPool`
+    PlannerConfig threadedConfig;
+    threadedConfig.beamWidth = 64;
+    threadedConfig.threads = 4;
+    Planner threadedPlanner(threadedConfig);
+
+    // a short recorder capacity, so the run wraps the recording (what a
+    // session longer than `REPLAY_MAX_TICKS` does) a few times
+    GameState gameState;
+    ReplayRecorder recorder;
+    recorder.begin(gameState, 600, 6000);
+    LevelStream levelStream;
+
+    // die every so often so restarts (new seed, new level) are covered too
+    const int maxAliveTicks = 1500;
+    int aliveTicks = 0;
+    int restarts = 0;
+    long badFrames = 0;
+    uint64_t badAllocs = 0;
+    float checksum = 0;
+
+    for (long frame = 0; frame < frames; frame++)
+    {
+        uint64_t before = AllocCounter::count();
+
+        PlanResult plan = planner.plan(gameState, 0);
+        bool flap = aliveTicks < maxAliveTicks ? plan.flap : false;
+        checksum += threadedPlanner.plan(gameState, 0).flap;
+
+        recorder.record(gameState, flap);
+        uint64_t seed = gameState.seed;
+        Sim::step(gameState, flap);
+        aliveTicks = gameState.running == RunningT::Running ? aliveTicks + 1 : 0;
+        restarts += gameState.seed != seed;
+
+        if (levelStream.seed() != gameState.seed)
+            levelStream.reset(gameState.seed);
+        for (int k = LevelStream::firstPipeAfter(gameState.xOffset); ; k++)
+        {
+            Vec2f pipe = levelStream.pipe(k);
+            if (pipe.x - gameState.xOffset >= SCREEN_W)
+                break;
+            checksum += pipe.y;
+        }
+
+        int digits[HUD_MAX_DIGITS];
+        int len = Hud::scoreDigits(gameState.score, digits);
+        checksum += digits[0];
+
+        // representative values; the formatting is what counts
+        HudText hudText;
+        size_t textLen = 0;
+        textLen += strlen(Hud::fps(hudText, FPS));
+        textLen += strlen(Hud::ticks(hudText, 1, (float)(frame % 60) / 60));
+        textLen += strlen(Hud::allocs(hudText, (int)(AllocCounter::count() - before), 0));
+        textLen += strlen(Hud::sprites(hudText, len + 8, 2));
+        textLen += strlen(Hud::draws(hudText, 3, (len + 8) * 4));
+        textLen += strlen(Hud::plan(hudText, plan.micros, plan.survives));
+        textLen += strlen(Hud::replayTick(hudText, recorder.replay.tickCount(), recorder.replay.tickCount()));
+        textLen += strlen(Hud::zoom(hudText, 1.0f));
+        textLen += strlen(Hud::profileThread(hudText, "sim", 1));
+        textLen += strlen(Hud::profileStat(hudText, 1, "plan", plan.micros / 1000.0));
+        checksum += textLen;
+
+        uint64_t allocs = AllocCounter::count() - before;
+        if (frame >= warmup && allocs > 0)
+        {
+            if (badFrames < 5)
+                printlog(0, "[alloc] frame %ld allocated %d times", frame, (int)allocs);
+            badFrames++;
+            badAllocs += allocs;
+        }
+    }
+
+    printlog(0, "[alloc] frames: %ld (warm-up %ld) | restarts: %d | recorded: %d ticks (checksum %.0f)",
+        frames, warmup, restarts, recorder.replay.tickCount(), checksum);
+    printlog(0, "[alloc] frames that allocated: %ld (%llu allocations)",
+        badFrames, (unsigned long long)badAllocs);
+
+    return badFrames == 0 ? 0 : 1;
+}
+
+static int run_triple(long publishes)
+{
+    // a writer publishing stepped games as fast as it can, a reader that
+    // checks every value it picks up: never torn, never older than the last
+    struct Frame
+    {
+        long seq = -1;
+        GameState gameState;
+        long check = -1;    // == seq when the slot was written completely
+    };
+    TripleBuffer<Frame> buffer;
+
+    std::atomic<bool> done(false);
+    long torn = 0;
+    long backwards = 0;
+    long fetched = 0;
+    long seen = -1;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread reader([&]()
+    {
+        while (true)
+        {
+            bool last = done.load(std::memory_order_acquire);
+            if (buffer.fetch())
+            {
+                const Frame& frame = buffer.front();
+                fetched++;
+                torn += frame.check != frame.seq || frame.gameState.anchorTicks != (int)(frame.seq & 0x7fffffff);
+                backwards += frame.seq <= seen;
+                seen = frame.seq;
+            }
+            if (last)
+                break;
+        }
+    });
+
+    GameState gameState;
+    for (long i = 0; i < publishes; i++)
+    {
+        Sim::step(gameState, (i % 23) == 0);
+
+        Frame& frame = buffer.back();
+        frame.seq = i;
+        frame.gameState = gameState;
+        frame.gameState.anchorTicks = (int)(i & 0x7fffffff); // tag
+        frame.check = i;
+        buffer.publish();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    double secs = seconds_since(start);
+
+    printlog(0, "[triple] published: %ld | fetched: %ld (%.1f%%) | last: %ld",
+        publishes, fetched, 100.0 * fetched / publishes, seen);
+    printlog(0, "[triple] %.2f M publishes/s | torn: %ld | out of order: %ld",
+        publishes / secs / 1e6, torn, backwards);
+
+    return torn == 0 && backwards == 0 && seen == publishes - 1 ? 0 : 1;
+}
+
+static int run_profile(long ticks, const char *path)
+{
+    if (!Profiler::enabled())
+    {
+        printlog(0, "[profile] profiler compiled out (PROFILER_ENABLED=0), skipping");
+        return 0;
+    }
+    Profiler::nameThread("headless");
+
+    // cost of an empty scope
+    const long scopes = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < scopes; i++)
+    {
+        PROFILE_SCOPE("empty");
+    }
+    double scopeNs = seconds_since(start) / scopes * 1e9;
+
+    // a nested workload: planner + ticks, as the app's sim thread does
+    PlannerConfig config;
+    config.beamWidth = 16;
+    Planner planner(config);
+    GameState gameState;
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < ticks; i++)
+    {
+        PROFILE_SCOPE("update");
+        bool flap;
+        {
+            PROFILE_SCOPE("plan");
+            flap = planner.plan(gameState, 0).flap;
+        }
+        {
+            PROFILE_SCOPE("tick");
+            Sim::step(gameState, flap);
+        }
+    }
+    double secs = seconds_since(start);
+
+    ProfileStat stats[8];
+    int numStats = Profiler::summarize(secs * 1e3 + 1, stats, 8);
+
+    printlog(0, "[profile] empty scope: %.1f ns | %ld ticks in %.3f s", scopeNs, ticks, secs);
+    for (int i = 0; i < numStats; i++)
+        printlog(0, "[profile] %*s%-8s calls: %6d | avg: %8.4f ms | total: %8.2f ms",
+            stats[i].depth * 2, "", stats[i].name, stats[i].calls, stats[i].avgMs(), stats[i].totalMs);
+
+    return Profiler::exportTrace(path) ? 0 : 1;
+}
+
+static int run_pack(const char *path, int opens)
+{
+    bool embedded = (strcmp(path, "embedded") == 0);
+    auto open = [&](AssetPack& pack) {
+        return embedded ? pack.openEmbedded() : pack.open(path);
+    };
+
+    // first open: includes faulting the file in if it isn't cached yet
+    auto start = std::chrono::steady_clock::now();
+    AssetPack pack;
+    if (!open(pack))
+        return 1;
+    double firstMs = seconds_since(start) * 1e3;
+
+    printlog(0, "[pack] '%s': %d sprites, %d pages", path, pack.spriteCount(), pack.pageCount());
+    for (int i = 0; i < pack.pageCount(); i++)
+        printlog(0, "[pack]   page %d: %ux%u, %.1f KiB", i,
+            pack.page(i).width, pack.page(i).height, pack.page(i).size / 1024.0);
+    pack.close();
+
+    // warm: map, validate and read every page as the GPU upload would
+    uint32_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int n = 0; n < opens; n++)
+    {
+        if (!open(pack))
+            return 1;
+        for (int i = 0; i < pack.pageCount(); i++)
+        {
+            const uint32_t *px = (const uint32_t *)pack.pixels(i);
+            size_t count = pack.page(i).size / 4;
+            for (size_t p = 0; p < count; p++)
+                checksum += px[p];
+        }
+        pack.close();
+    }
+    double secs = seconds_since(start);
+
+    printlog(0, "[pack] first open: %.3f ms | open + read: %.3f ms avg over %d (checksum %08x)",
+        firstMs, secs * 1e3 / opens, opens, checksum);
+    return 0;
+}
+
+static int run_audio(long ticks, const char *path)
+{
+    /**
+     * queue: one thread pushes a sequence (retrying when full), the other
+     * must pop all of it in order
+     */
+    const long pushes = 2000000;
+    SpscQueue<long, 64> queue;
+    long outOfOrder = 0;
+    long full = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]()
+    {
+        long expected = 0;
+        long value;
+        while (expected < pushes)
+        {
+            if (!queue.pop(value))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            outOfOrder += (value != expected);
+            expected = value + 1;
+        }
+    });
+    for (long i = 0; i < pushes; i++)
+    {
+        while (!queue.push(i))
+        {
+            full++;
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    double secs = seconds_since(start);
+
+    printlog(0, "[audio] queue: %.2f M values/s | out of order: %ld | pushes on a full queue: %ld",
+        pushes / secs / 1e6, outOfOrder, full);
+
+    /**
+     * clips, decoded once
+     */
+    AudioEngine engine;
+    start = std::chrono::steady_clock::now();
+    bool loaded = engine.load(AUDIO_DIR);
+    double loadMs = seconds_since(start) * 1e3;
+    if (!loaded)
+        return 1;
+
+    int totalFrames = 0;
+    for (int i = 0; i < SOUND_COUNT; i++)
+        totalFrames += engine.clip((SoundId)i).frames();
+    printlog(0, "[audio] decoded %d clips in %.2f ms (%.2f s of PCM, %d KiB)",
+        SOUND_COUNT, loadMs, (double)totalFrames / AUDIO_SAMPLE_RATE, totalFrames * 4 / 1024);
+
+    /**
+     * offline: the sounds of a scripted run, mixed tick by tick into `path`
+     * (the same samples every run)
+     */
+    {
+        WavAudioDevice wav(path, false);
+        int periodFrames = AUDIO_PERIOD_FRAMES;
+        if (!wav.open(AUDIO_SAMPLE_RATE, periodFrames))
+            return 1;
+
+        std::vector<int16_t> out(AUDIO_MAX_PERIOD_FRAMES * 2);
+        GameState gameState;
+        int64_t mixed = 0;
+        int deaths = 0;
+        int scores = 0;
+        int peak = 0;
+        for (long t = 0; t < ticks; t++)
+        {
+            // the bird gives up every fourth 10 s, so it also dies / restarts
+            GameState prev = gameState;
+            bool giveUp = (t / 600) % 4 == 3 && gameState.running == RunningT::Running;
+            bool flap = autopilot(gameState) && !giveUp;
+            Sim::step(gameState, flap);
+            engine.playTick(prev, gameState, flap);
+            deaths += (prev.running == RunningT::Running && gameState.running != RunningT::Running);
+            scores += (gameState.score > prev.score);
+
+            // this tick's share of the output, rounded so ticks add up
+            int64_t until = (int64_t)((t + 1) * (double)AUDIO_SAMPLE_RATE * DELTA_TIME + 0.5);
+            int frames = (int)(until - mixed);
+            engine.render(out.data(), frames);
+            wav.write(out.data(), frames);
+            mixed = until;
+
+            for (int k = 0; k < frames * 2; k++)
+                peak = Math::max(peak, abs(out[k]));
+        }
+        wav.close();
+
+        printlog(0, "[audio] offline: %ld ticks -> '%s' (%.1f s) | points: %d | deaths: %d | sounds: %d (dropped %d, stolen %d) | peak: %d",
+            ticks, path, (double)mixed / AUDIO_SAMPLE_RATE, scores, deaths,
+            engine.played(), engine.dropped(), engine.stolen(), peak);
+        // never at full scale (see `AUDIO_LIMIT_CEILING`)
+        int ceiling = (int)(AUDIO_LIMIT_CEILING * 32767);
+        if (engine.dropped() > 0 || peak == 0 || peak > ceiling)
+            return 1;
+
+        // worst case: every sound twice at once, at twice the gain
+        for (int i = 0; i < 2 * SOUND_COUNT; i++)
+            engine.play((SoundId)(i % SOUND_COUNT), 2);
+        int stackedPeak = 0;
+        for (int i = 0; i < AUDIO_SAMPLE_RATE / AUDIO_PERIOD_FRAMES; i++)
+        {
+            engine.render(out.data(), AUDIO_PERIOD_FRAMES);
+            for (int k = 0; k < AUDIO_PERIOD_FRAMES * 2; k++)
+                stackedPeak = Math::max(stackedPeak, abs(out[k]));
+        }
+        printlog(0, "[audio] headroom: peak %d, %d stacked | ceiling %d (full scale 32767)",
+            peak, stackedPeak, ceiling);
+        if (stackedPeak > ceiling)
+            return 1;
+    }
+
+    /**
+     * real time: the mixer thread into a null device, a sound every 50 ms;
+     * once with our period, once with raylib's (`RAYLIB_AUDIO_PERIOD`, what
+     * the game gets). The latencies depend on the scheduler, so they are
+     * only reported (expect up to the period a sound waits for plus the one
+     * the device still has queued); every sound must get played
+     */
+    struct
+    {
+        const char *name;
+        int periodFrames;   // 0: the mixer's choice
+    } devices[] = {
+        { "null", 0 },
+        { "null, raylib period", 4096 },
+    };
+
+    bool ok = outOfOrder == 0;
+    for (auto& d : devices)
+    {
+        AudioEngine live;
+        live.load(AUDIO_DIR);
+        NullAudioDevice device(d.periodFrames);
+        if (!live.start(&device))
+            return 1;
+
+        const int plays = 40;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < plays; i++)
+        {
+            live.play((SoundId)(i % SOUND_COUNT));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        // the last ones still have to be mixed
+        double periodMs = 1e3 * live.periodFrames() / AUDIO_SAMPLE_RATE;
+        std::this_thread::sleep_for(std::chrono::microseconds((int64_t)(2e3 * periodMs)));
+        secs = seconds_since(start);
+        live.stop();
+
+        printlog(0, "[audio] real time (%s): %.2f s | mixed %.2f s | period %.1f ms | played %d / %d (dropped %d)",
+            d.name, secs, (double)device.framesWritten() / AUDIO_SAMPLE_RATE, periodMs,
+            live.played(), plays, live.dropped());
+        printlog(0, "[audio]   play -> mixer avg %.2f ms, max %.2f ms | play -> output avg %.2f ms, max %.2f ms",
+            live.queueLatencyAvgUs() / 1e3, live.queueLatencyMaxUs() / 1e3,
+            live.outputLatencyAvgUs() / 1e3, live.outputLatencyMaxUs() / 1e3);
+
+        ok = ok && live.played() == plays && live.dropped() == 0;
+    }
+    return ok ? 0 : 1;
+}
+
+
+/**
+ * -----------------------------------------------------------------------------
+ * /////////////////////////// <<  MAIN  >> ////////////////////////////////////
+ * -----------------------------------------------------------------------------
+ */
+int main(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "sim";
+
+    if (strcmp(mode, "batch") == 0)
+    {
+        int envs = argc > 2 ? atoi(argv[2]) : 4096;
+        long ticks = argc > 3 ? atol(argv[3]) : 2000;
+        return run_batch(envs, ticks);
+    }
+    if (strcmp(mode, "clone") == 0)
+    {
+        long clones = argc > 2 ? atol(argv[2]) : 1000000;
+        int ticks = argc > 3 ? atoi(argv[3]) : 16;
+        return run_clone(clones, ticks);
+    }
+    if (strcmp(mode, "plan") == 0)
+    {
+        long ticks = argc > 2 ? atol(argv[2]) : 20000;
+        int budgetMicros = argc > 3 ? atoi(argv[3]) : 1000;
+        int threads = argc > 4 ? atoi(argv[4]) : 1;
+        return run_plan(ticks, budgetMicros, threads);
+    }
+    if (strcmp(mode, "threads") == 0)
+    {
+        int envs = argc > 2 ? atoi(argv[2]) : 65536;
+        long ticks = argc > 3 ? atol(argv[3]) : 1000;
+        int maxThreads = argc > 4 ? atoi(argv[4]) : 0;
+        return run_threads(envs, ticks, maxThreads);
+    }
+    if (strcmp(mode, "verify") == 0)
+    {
+        int envs = argc > 2 ? atoi(argv[2]) : 64;
+        long ticks = argc > 3 ? atol(argv[3]) : 20000;
+        return run_verify(envs, ticks);
+    }
+    if (strcmp(mode, "replay") == 0)
+    {
+        long ticks = argc > 2 ? atol(argv[2]) : 100000;
+        const char *path = argc > 3 ? argv[3] : "headless.flpr";
+        return run_replay(ticks, path);
+    }
+    if (strcmp(mode, "collide") == 0)
+    {
+        int count = argc > 2 ? atoi(argv[2]) : 4099; // not a multiple of LANES
+        int reps = argc > 3 ? atoi(argv[3]) : 10000;
+        return run_collide(count, reps);
+    }
+    if (strcmp(mode, "swept") == 0)
+    {
+        int games = argc > 2 ? atoi(argv[2]) : 1000;
+        int stepTicks = argc > 3 ? atoi(argv[3]) : 8;
+        return run_swept(games, stepTicks);
+    }
+    if (strcmp(mode, "ffwd") == 0)
+    {
+        int games = argc > 2 ? atoi(argv[2]) : 100;
+        long ticks = argc > 3 ? atol(argv[3]) : 100000;
+        return run_ffwd(games, ticks);
+    }
+    if (strcmp(mode, "level") == 0)
+    {
+        long lookups = argc > 2 ? atol(argv[2]) : 20000000;
+        int threads = argc > 3 ? atoi(argv[3]) : 0;
+        return run_level(lookups, threads);
+    }
+    if (strcmp(mode, "alloc") == 0)
+    {
+        long frames = argc > 2 ? atol(argv[2]) : 20000;
+        long warmup = argc > 3 ? atol(argv[3]) : 600;
+        return run_alloc(frames, warmup);
+    }
+    if (strcmp(mode, "triple") == 0)
+    {
+        long publishes = argc > 2 ? atol(argv[2]) : 5000000;
+        return run_triple(publishes);
+    }
+    if (strcmp(mode, "profile") == 0)
+    {
+        long ticks = argc > 2 ? atol(argv[2]) : 3000;
+        const char *path = argc > 3 ? argv[3] : "headless-trace.json";
+        return run_profile(ticks, path);
+    }
+    if (strcmp(mode, "pack") == 0)
+    {
+        const char *path = argc > 2 ? argv[2] :
+            (EMBED_ASSETS ? "embedded" : "resources/production/textures.pack");
+        int opens = argc > 3 ? atoi(argv[3]) : 100;
+        return run_pack(path, opens);
+    }
+    if (strcmp(mode, "audio") == 0)
+    {
+        long ticks = argc > 2 ? atol(argv[2]) : 3600;
+        const char *path = argc > 3 ? argv[3] : "headless-audio.wav";
+        return run_audio(ticks, path);
+    }
+
+    // default: single game
+    long ticks = argc > 2 ? atol(argv[2]) : (argc > 1 ? atol(argv[1]) : 0);
+    return run_sim(ticks > 0 ? ticks : 10000000);
+}
@@ -5,12 +5,37 @@
  */
 
 #include <iostream>
+#include <time.h>
+#include <chrono>
+#include <thread>
 #include "common.hpp"
 
 #include "State.hpp"
 #include "Game.hpp"
 #include "Input.hpp"
 #include "Renderer.hpp"
+#include "RaylibAudio.hpp"
+#include "core/Planner.hpp"
+#include "core/Replay.hpp"
+#include "core/AllocCounter.hpp"
+#include "core/TripleBuffer.hpp"
+#include "core/Profiler.hpp"
+
+// the sim runs on its own thread, so a slow frame / vsync wait never delays
+// ticks and the reverse; the web build has no threads and steps it inline
+#if !defined(PLATFORM_WEB)
+    #define SIM_THREAD
+#endif
+
+#define REPLAY_FILE "replay.flpr"
+#define TRACE_FILE "trace.json"
+// uncapped playback: wall time spent stepping per frame (seconds)
+#define REPLAY_FAST_BUDGET 0.008
+// frames after which a frame is expected not to touch the heap (debug builds)
+#define ALLOC_WARMUP_FRAMES 120
+// frame cap in case the driver ignores `FLAG_VSYNC_HINT`; above any common
+// refresh rate, so it never fights vsync
+#define RENDER_FPS_CAP 240
 
 /**
  * wrapper object for app
@@ -18,10 +43,33 @@
 class App
 {
     public:
-    State state;
-    Renderer renderer; 
+    State state;        // sim thread
+    UiState ui;         // window thread
+    Renderer renderer;  // window thread
+    Planner planner;
+
+    // sim -> mixer thread (see `Game::update()`)
+    AudioEngine audio;
+    RaylibAudioDevice audioDevice;
+
+    // sim -> window: latest sim state; window -> sim: input / gui requests
+    TripleBuffer<FrameSnapshot> snapshots;
+    SimControls controls;
 
-    App()
+    // every live tick is recorded; `replay` is what the player watches
+    ReplayRecorder recorder;
+    Replay replay;
+    ReplayPlayer player;
+    bool replayActive = false;
+    bool replayLoaded = false; // `replay` came from a file, don't overwrite it
+    GameState liveGameState; // resumed when leaving the replay
+
+    // sim thread
+    std::thread simThread;
+    std::atomic<bool> simRunning;
+    int simUpdates = 0;
+
+    App() : simRunning(false)
     {
         printlog(0, "Creating App");
     }
@@ -36,52 +84,339 @@ class App
 App app;
 
 
+/**
+ * wall clock shared by both threads (seconds)
+ */
+double app_time()
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+
+/**
+ * -----------------------------------------------------------------------------
+ * SIM THREAD
+ * -----------------------------------------------------------------------------
+ */
+
+/**
+ * enter / leave replay mode when `State::replaying` changed
+ */
+void replay_sync()
+{
+    if (app.state.replaying == app.replayActive)
+        return;
+    app.replayActive = app.state.replaying;
+
+    if (app.replayActive)
+    {
+        if (!app.replayLoaded)
+            app.replay = app.recorder.replay;
+        app.replayLoaded = false;
+
+        app.liveGameState = app.state.gameState;
+        app.player.begin(&app.replay);
+        app.state.gameState = app.player.gameState;
+        app.state.replayLength = app.replay.tickCount();
+    }
+    else
+        app.state.gameState = app.liveGameState;
+
+    app.state.prevGameState = app.state.gameState;
+    app.state.accumulator = 0;
+    app.state.pendingPress = false;
+}
+
+/**
+ * advance the replay by one tick; false once it has ended. At 1x the tick
+ * goes through `Game::update()` like a live one, so replays make sound;
+ * uncapped playback (`sound` false) stays silent
+ */
+bool replay_step(bool sound)
+{
+    if (!sound)
+    {
+        if (!app.player.step())
+            return false;
+        app.state.gameState = app.player.gameState;
+        return true;
+    }
+
+    bool flap;
+    if (!app.player.input(flap))
+        return false;
+    Game::update(app.state, flap);
+    app.player.gameState = app.state.gameState;
+    return true;
+}
+
+/**
+ * copy what the renderer needs into the back snapshot and hand it over
+ */
+void sim_publish(double now, int allocs)
+{
+    auto& state = app.state;
+    FrameSnapshot& frame = app.snapshots.back();
+
+    frame.gameState = state.gameState;
+    frame.prevGameState = state.prevGameState;
+    frame.time = now;
+    frame.accumulator = state.accumulator;
+    bool clockRuns = state.canUpdate && !(app.replayActive && state.replayFast);
+    frame.timeScale = clockRuns ? 1.0f / state.ticksPerUpdate : 0;
+    frame.ticks = state.ticksThisFrame;
+    frame.plannerMicros = state.plannerMicros;
+    frame.plannerSurvives = state.plannerSurvives;
+    frame.replaying = app.replayActive;
+    frame.replayTick = state.replayTick;
+    frame.replayLength = state.replayLength;
+    frame.simAllocs = allocs;
+
+    app.snapshots.publish();
+}
+
+/**
+ * apply the window's requests, run the ticks that are due at wall time `now`
+ * and publish the result
+ */
+void sim_update(double now)
+{
+    PROFILE_SCOPE("sim");
+    uint64_t allocsBefore = AllocCounter::count();
+    // replay toggles / saves / seeks copy or load replays; those may allocate
+    bool userAction = false;
+
+    auto& state = app.state;
+    auto& controls = app.controls;
+
+    /**
+     * handle requests
+     * ----------------
+     */
+    state.canUpdate = controls.canUpdate.load(std::memory_order_relaxed);
+    state.autopilot = controls.autopilot.load(std::memory_order_relaxed);
+    state.replayFast = controls.replayFast.load(std::memory_order_relaxed);
+    state.replaying = controls.replaying.load(std::memory_order_relaxed);
+    state.pendingPress |= controls.presses.exchange(0, std::memory_order_relaxed) > 0;
+
+    userAction |= (state.replaying != app.replayActive);
+    replay_sync();
+
+    if (controls.saveReplay.exchange(false, std::memory_order_relaxed))
+    {
+        userAction = true;
+        if (app.recorder.replay.save(REPLAY_FILE))
+            printlog(0, "saved replay (%i ticks) to " REPLAY_FILE, app.recorder.replay.tickCount());
+    }
+
+    // scrubber: jump straight to the requested tick
+    int seek = controls.replaySeek.exchange(-1, std::memory_order_relaxed);
+    if (app.replayActive && seek >= 0)
+    {
+        userAction = true;
+        app.player.seek(seek);
+        state.gameState = app.player.gameState;
+        state.prevGameState = state.gameState;
+        state.accumulator = 0;
+    }
+
+
+    /**
+     * update game
+     * ------------
+     * run 0..k fixed ticks for the real time that passed, so game speed
+     * doesn't depend on how often we get here; `ticksPerUpdate` slows time
+     * down
+     */
+    // ignore huge hitches (e.g. machine suspended)
+    float elapsed = Math::min((float)(now - state.lastTime), 0.25f);
+    state.lastTime = now;
+    state.ticksThisFrame = 0;
+
+    if (state.canUpdate)
+    {
+        state.accumulator += elapsed / state.ticksPerUpdate;
+
+        // uncapped replay: as many ticks as fit in the budget
+        if (app.replayActive && state.replayFast)
+        {
+            double start = app_time();
+            state.prevGameState = state.gameState;
+            while (app_time() - start < REPLAY_FAST_BUDGET && replay_step(false))
+                state.ticksThisFrame++;
+            state.accumulator = 0;
+        }
+
+        while (
+            state.accumulator >= DELTA_TIME &&
+            state.ticksThisFrame < state.maxTicksPerFrame
+        ) {
+            state.prevGameState = state.gameState;
+
+            if (app.replayActive)
+            {
+                if (!replay_step(true))
+                {
+                    state.accumulator = 0;
+                    break;
+                }
+                state.accumulator -= DELTA_TIME;
+                state.ticksThisFrame++;
+                continue;
+            }
+
+            // a press only counts for one tick
+            bool flap = state.pendingPress;
+            state.pendingPress = false;
+
+            // autopilot: the planner decides this tick's input
+            if (state.autopilot)
+            {
+                PROFILE_SCOPE("plan");
+                auto plan = app.planner.plan(state.gameState, state.plannerBudgetMicros);
+                flap = plan.flap;
+                state.plannerMicros = plan.micros;
+                state.plannerSurvives = plan.survives;
+            }
+
+            app.recorder.record(state.gameState, flap);
+            Game::update(state, flap);
+
+            state.accumulator -= DELTA_TIME;
+            state.ticksThisFrame++;
+        }
+
+        // can't keep up: drop the backlog instead of spiralling
+        if (state.ticksThisFrame == state.maxTicksPerFrame)
+            state.accumulator = Math::min(state.accumulator, DELTA_TIME);
+    }
+
+    if (app.replayActive)
+        state.replayTick = app.player.tick;
+
+    int allocs = (int)(AllocCounter::count() - allocsBefore);
+    if (allocs > 0 && !userAction && app.simUpdates > ALLOC_WARMUP_FRAMES)
+        printlog(1, "sim update %i allocated %i times", app.simUpdates, allocs);
+    app.simUpdates++;
+
+    sim_publish(now, allocs);
+}
+
+#if defined(SIM_THREAD)
+void sim_thread_main()
+{
+    Profiler::nameThread("sim");
+
+    while (app.simRunning.load(std::memory_order_relaxed))
+    {
+        sim_update(app_time());
+
+        // sleep until the next tick is due; presses are only applied on
+        // ticks, so waking up earlier wouldn't make input any faster
+        auto& state = app.state;
+        double wait = 1.0 / FPS;
+        if (state.canUpdate && app.replayActive && state.replayFast)
+            wait = 0;
+        else if (state.canUpdate)
+            wait = Math::max(DELTA_TIME - state.accumulator, 0) * state.ticksPerUpdate;
+
+        if (wait > 0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+        else
+            std::this_thread::yield();
+    }
+}
+#endif
+
+
+/**
+ * -----------------------------------------------------------------------------
+ * WINDOW THREAD
+ * -----------------------------------------------------------------------------
+ */
 void game_update()
 {
+    PROFILE_SCOPE("frame");
+    uint64_t allocsBefore = AllocCounter::count();
+    // trace exports write a file; may allocate
+    bool userAction = false;
+    auto& ui = app.ui;
+    auto& controls = app.controls;
+
     /**
      * update time 
      * ------------
      */
-    app.state.tick += 1;
-    app.state.frameTime = GetFrameTime();
-    // printlog(1, "%f", app.state.frameTime);
-    if (app.state.frameTime != 0)
-        app.state.fps = 1.0f / app.state.frameTime;
-    // printlog(0, "fps: %d | frameTime %f", app.state.fps, app.state.frameTime);
+    ui.tick += 1;
+    ui.frameTime = GetFrameTime();
+    // printlog(1, "%f", ui.frameTime);
+    if (ui.frameTime != 0)
+        ui.fps = 1.0f / ui.frameTime;
+    // printlog(0, "fps: %d | frameTime %f", ui.fps, ui.frameTime);
     
     /**
      * handle input 
      * -------------
      */
-    Input::update(app.state);
-
+    Input::update(ui);
 
-    /**
-     * update game
-     * ------------
-     */
-    if (
-        app.state.canUpdate &&
-        (
-            app.state.ticksPerUpdate == 1 ||
-            app.state.tick % app.state.ticksPerUpdate == 0
-        )
-    ) {
-        Game::update(app.state);
+    // nothing to flap at behind the loading screen
+    bool loaded = app.renderer.loaded();
+    if (ui.inputState.mousePressed && loaded)
+        controls.presses.fetch_add(1, std::memory_order_relaxed);
+    if (ui.inputState.toggleReplay)
+        ui.replaying = !ui.replaying;
+    if (ui.inputState.saveReplay)
+        controls.saveReplay.store(true, std::memory_order_relaxed);
+    if (ui.inputState.exportTrace)
+    {
+        userAction = true;
+        Profiler::exportTrace(TRACE_FILE);
     }
+    controls.replaying.store(ui.replaying, std::memory_order_relaxed);
+
+    #if !defined(SIM_THREAD)
+        sim_update(app_time());
+    #endif
+    #if !defined(AUDIO_THREAD)
+        app.audio.pump();
+    #endif
 
 
     /**
      * Draw
      * ------
+     * the newest published snapshot (the sim may have moved on already)
      */
+    app.snapshots.fetch();
+    const FrameSnapshot& frame = app.snapshots.front();
+    ui.renderAlpha = frame.alpha(app_time());
+
     app.renderer.render(
-        &app.state
+        frame,
+        &ui
     );
 
-    // if (app.state.tick % 200 == 1)
+    // sounds were decoded by the loader; mix from now on
+    if (!loaded && app.renderer.loaded())
+        app.audio.start(&app.audioDevice);
+
+    // gui changes go to the sim; it's held until the assets are in
+    controls.canUpdate.store(ui.canUpdate && loaded, std::memory_order_relaxed);
+    controls.autopilot.store(ui.autopilot, std::memory_order_relaxed);
+    controls.replaying.store(ui.replaying, std::memory_order_relaxed);
+    controls.replayFast.store(ui.replayFast, std::memory_order_relaxed);
+    if (ui.replaySeek >= 0)
+    {
+        controls.replaySeek.store(ui.replaySeek, std::memory_order_relaxed);
+        ui.replaySeek = -1;
+    }
+
+    // if (ui.tick % 200 == 1)
     // {
-    //     println("[DEBUG : %5i] ", app.state.tick);
+    //     println("[DEBUG : %5i] ", ui.tick);
     // }
 
 
@@ -89,7 +424,11 @@ void game_update()
      * finish app loop iteration
      * --------------------------
      */
-    app.state.tick++;
+    ui.frameAllocs = (int)(AllocCounter::count() - allocsBefore);
+    if (ui.frameAllocs > 0 && !userAction && ui.tick > ALLOC_WARMUP_FRAMES)
+        printlog(1, "frame %i allocated %i times", ui.tick, ui.frameAllocs);
+
+    ui.tick++;
 }
 
 
@@ -112,6 +451,8 @@ int main(int argc, char **argv)
      * Initialization
      * --------------
      */
+    Profiler::nameThread("main");
+
     SetConfigFlags(
         // FLAG_SHOW_LOGO |
         FLAG_VSYNC_HINT |
@@ -121,13 +462,42 @@ int main(int argc, char **argv)
         0
     );
 	InitWindow(
-        app.state.screenWidth * app.renderer.platformRenderScale,
-        app.state.screenHeight * app.renderer.platformRenderScale,
+        app.ui.screenWidth * app.renderer.platformRenderScale,
+        app.ui.screenHeight * app.renderer.platformRenderScale,
         "FLAPPY"
     );
 
+    InitAudioDevice();
+    app.state.audio = &app.audio;
+
+    // returns right away; the first frames show the loading screen
+    app.renderer.loader.addAudio(&app.audio);
     app.renderer.init();
 
+    // each launch plays a different level (restarts derive their own seed)
+    app.state.gameState = GameState(
+        (uint64_t)time(NULL),
+        Level::pipesFor(app.ui.screenWidth)
+    );
+    app.recorder.begin(app.state.gameState);
+
+    // `flappy <file>.flpr` starts by watching a saved replay
+    if (argc > 1 && app.replay.load(argv[1]))
+    {
+        app.replayLoaded = true;
+        app.ui.replaying = true;
+        app.controls.replaying.store(true);
+    }
+
+    // first snapshot, then hand the sim to its thread
+    app.state.prevGameState = app.state.gameState;
+    app.state.lastTime = app_time();
+    sim_publish(app.state.lastTime, 0);
+    #if defined(SIM_THREAD)
+        app.simRunning.store(true);
+        app.simThread = std::thread(sim_thread_main);
+    #endif
+
     /**
      * BEGIN Main app loop
      * --------------------
@@ -135,8 +505,10 @@ int main(int argc, char **argv)
     #if defined(PLATFORM_WEB)
         emscripten_set_main_loop(game_update, 0, 1);
     #else
-        SetTargetFPS(FPS);
-
+        // vsync paces frames and the sim runs on its own fixed-step clock
+        // (see `sim_update()`), the cap only keeps the window thread from
+        // spinning a core when vsync is off
+        SetTargetFPS(RENDER_FPS_CAP);
         while (!WindowShouldClose()) // Detect window close button or ESC key
         {
             game_update();
@@ -147,6 +519,17 @@ int main(int argc, char **argv)
      * De-Initialization
      * -----------------
      */
+    #if defined(SIM_THREAD)
+        app.simRunning.store(false);
+        app.simThread.join();
+    #endif
+    app.audio.stop();
+    CloseAudioDevice();
+    if (app.audio.played() > 0)
+        printlog(1, "audio: %i sounds | play -> output avg %.1f ms, max %.1f ms (period %i frames)",
+            app.audio.played(), app.audio.outputLatencyAvgUs() / 1e3,
+            app.audio.outputLatencyMaxUs() / 1e3, app.audio.periodFrames());
+
     // Close window and OpenGL context
 	CloseWindow();        
 
@@ -0,0 +1,102 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/AtlasJson.hpp
+ * - reads the atlas description shared by the build tools: TexturePacker's
+ *   "JSON (Hash)" format, as exported from `spritesheet.tps` or written by
+ *   `atlasgen`
+ * - frame sizes in the file are the sprite's own (unrotated) size; a
+ *   `rotated` sprite is stored turned 90 degrees clockwise, so it covers
+ *   `h` x `w` atlas pixels
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdio.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+
+struct AtlasFrame
+{
+    std::string key;
+    // rect covered in the atlas (px, already swapped if `rotated`)
+    int x, y, w, h;
+    bool rotated;
+    // trimmed pixels start at (`ox`, `oy`) in the untrimmed `sw` x `sh`
+    // sprite
+    int ox, oy, sw, sh;
+};
+
+
+/**
+ * frames in key order (json objects iterate sorted), i.e. `SpriteId` order;
+ * logs as `tool` and returns false on errors
+ */
+inline bool load_atlas_json(
+    const char *path, const char *tool,
+    std::vector<AtlasFrame>& frames, int& atlasW, int& atlasH
+) {
+    using nlohmann::json;
+
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "%s: can't open '%s'\n", tool, path);
+        return false;
+    }
+
+    json j;
+    try {
+        in >> j;
+
+        atlasW = j["meta"]["size"]["w"];
+        atlasH = j["meta"]["size"]["h"];
+        if (atlasW <= 0 || atlasH <= 0) {
+            fprintf(stderr, "%s: '%s': bad atlas size\n", tool, path);
+            return false;
+        }
+
+        frames.clear();
+        auto& jframes = j["frames"];
+        for (auto it = jframes.begin(); it != jframes.end(); ++it)
+        {
+            auto& jf = it.value();
+            auto& f = jf["frame"];
+
+            AtlasFrame frame;
+            frame.key = it.key();
+            frame.rotated = jf.value("rotated", false);
+            frame.x = f["x"];
+            frame.y = f["y"];
+            int w = f["w"];
+            int h = f["h"];
+            frame.w = frame.rotated ? h : w;
+            frame.h = frame.rotated ? w : h;
+
+            // untrimmed sprites may leave these out
+            frame.ox = 0;
+            frame.oy = 0;
+            frame.sw = w;
+            frame.sh = h;
+            if (jf.value("trimmed", false)) {
+                frame.ox = jf["spriteSourceSize"]["x"];
+                frame.oy = jf["spriteSourceSize"]["y"];
+                frame.sw = jf["sourceSize"]["w"];
+                frame.sh = jf["sourceSize"]["h"];
+            }
+
+            if (frame.x < 0 || frame.y < 0 || frame.x + frame.w > atlasW || frame.y + frame.h > atlasH) {
+                fprintf(stderr, "%s: '%s': frame '%s' is outside the atlas\n", tool, path, frame.key.c_str());
+                return false;
+            }
+            frames.push_back(frame);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s: '%s': %s\n", tool, path, e.what());
+        return false;
+    }
+
+    return true;
+}
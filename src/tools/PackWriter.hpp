@@ -0,0 +1,120 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/PackWriter.hpp
+ * - writes an `AssetPack` (see `core/AssetPack.hpp`); shared by `packer`
+ *   and `atlasgen`
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "core/AssetPack.hpp"
+
+
+struct PackPageData
+{
+    int width, height;
+    const void *pixels;         // RGBA8, `width` * `height` * 4 bytes
+};
+
+
+/**
+ * `PackSprite` for `key` (truncated keys are an error), uvs from its rect
+ * and the page size
+ */
+inline bool make_pack_sprite(
+    PackSprite& s, const std::string& key, int page, int pageW, int pageH,
+    int x, int y, int w, int h, bool rotated, int ox, int oy, int sw, int sh
+) {
+    if (key.size() >= PACK_KEY_SIZE)
+        return false;
+
+    memset(&s, 0, sizeof(s));
+    memcpy(s.key, key.c_str(), key.size());
+    s.page = page;
+    s.x = x;
+    s.y = y;
+    s.w = w;
+    s.h = h;
+    s.u = s.x / pageW;
+    s.v = s.y / pageH;
+    s.uw = s.w / pageW;
+    s.vh = s.h / pageH;
+    s.ox = ox;
+    s.oy = oy;
+    s.sw = sw;
+    s.sh = sh;
+    s.rotated = rotated ? 1 : 0;
+    return true;
+}
+
+
+inline bool pack_write_at(FILE *out, uint64_t offset, const void *data, size_t size)
+{
+    return fseek(out, (long)offset, SEEK_SET) == 0 && fwrite(data, 1, size, out) == size;
+}
+
+
+/**
+ * `sprites` must be in `SpriteId` (key) order; written to a temp file first
+ * so a failed run never leaves a half pack. Returns the file size, 0 on
+ * errors (logged as `tool`)
+ */
+inline uint64_t write_pack(
+    const char *path, const char *tool,
+    const std::vector<PackSprite>& sprites, const std::vector<PackPageData>& pages
+) {
+    if (pages.empty() || pages.size() > PACK_MAX_PAGES) {
+        fprintf(stderr, "%s: %d pages (1..%d supported)\n", tool, (int)pages.size(), PACK_MAX_PAGES);
+        return 0;
+    }
+
+    PackHeader header;
+    header.spriteCount = (uint32_t)sprites.size();
+    header.pageCount = (uint32_t)pages.size();
+    header.spriteOffset = sizeof(PackHeader);
+    header.pageOffset = header.spriteOffset + header.spriteCount * sizeof(PackSprite);
+
+    std::vector<PackPage> table(pages.size());
+    uint64_t offset = header.pageOffset + table.size() * sizeof(PackPage);
+    for (size_t i = 0; i < pages.size(); i++)
+    {
+        PackPage& p = table[i];
+        memset(&p, 0, sizeof(p));
+        p.width = pages[i].width;
+        p.height = pages[i].height;
+        p.format = PACK_FORMAT_RGBA8;
+        p.offset = (offset + PACK_PAGE_ALIGN - 1) / PACK_PAGE_ALIGN * PACK_PAGE_ALIGN;
+        p.size = (uint64_t)p.width * p.height * 4;
+        offset = p.offset + p.size;
+    }
+    header.fileSize = offset;
+
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE *out = fopen(tmpPath.c_str(), "wb");
+    if (!out) {
+        fprintf(stderr, "%s: can't write '%s'\n", tool, tmpPath.c_str());
+        return 0;
+    }
+
+    bool ok = pack_write_at(out, 0, &header, sizeof(header));
+    ok = ok && pack_write_at(out, header.spriteOffset, sprites.data(), sprites.size() * sizeof(PackSprite));
+    ok = ok && pack_write_at(out, header.pageOffset, table.data(), table.size() * sizeof(PackPage));
+    // gaps before the pages are zero filled by the seeks
+    for (size_t i = 0; ok && i < pages.size(); i++)
+        ok = pack_write_at(out, table[i].offset, pages[i].pixels, (size_t)table[i].size);
+
+    ok = ok && (ferror(out) == 0);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), path) != 0) {
+        fprintf(stderr, "%s: can't write '%s'\n", tool, path);
+        remove(tmpPath.c_str());
+        return 0;
+    }
+
+    return header.fileSize;
+}
@@ -0,0 +1,617 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/atlasgen.cpp
+ * - build step: packs every png in `resources/flappy_assets/sprites` into
+ *   one atlas page (MaxRects, best short side fit) with transparent borders trimmed
+ *   and sprites turned 90 degrees where that packs tighter. Writes the
+ *   `AssetPack` the game loads plus the atlas description (`AtlasJson.hpp`
+ *   format) `spritegen` turns into `Sprites.hpp`
+ * - incremental: a cache remembers every sprite's file hash, trim and place;
+ *   unchanged sprites are copied from the previous pack instead of decoded,
+ *   and the layout is only recomputed when a trimmed size / the set of
+ *   sprites changes. The description is only rewritten when it changes, so
+ *   a pixel edit doesn't rebuild the code.
+ *
+ * usage:
+ *   atlasgen <sprites dir> <textures.json> <textures.pack> <cache>
+ * -----------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <dirent.h>
+#include <utime.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+#include "json.hpp"
+
+#include "PackWriter.hpp"
+
+
+#define ATLAS_PADDING       2       // px between sprites (no bleeding)
+#define ATLAS_MIN_SIZE      64
+#define ATLAS_MAX_SIZE      4096
+#define ATLAS_CACHE_VERSION 1
+
+
+struct IntRect
+{
+    int x, y, w, h;
+};
+
+
+struct Sprite
+{
+    std::string key;            // file name without ".png"
+    std::string path;
+    uint64_t hash = 0;          // of the png file
+
+    int sw = 0, sh = 0;         // untrimmed size
+    IntRect trim = { 0, 0, 0, 0 }; // kept pixels within the untrimmed sprite
+    std::vector<uint32_t> pixels; // `trim.w` x `trim.h`, RGBA8
+
+    // place in the atlas (`trim.h` x `trim.w` px there if `rotated`)
+    int x = 0, y = 0;
+    bool rotated = false;
+};
+
+
+/**
+ * Helpers
+ * -------
+ */
+
+// FNV-1a
+static uint64_t hash_bytes(const std::vector<uint8_t>& bytes)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (uint8_t b : bytes)
+    {
+        h ^= b;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static bool read_file(const std::string& path, std::vector<uint8_t>& bytes)
+{
+    FILE *in = fopen(path.c_str(), "rb");
+    if (!in)
+        return false;
+    bytes.clear();
+    uint8_t buf[1 << 16];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+        bytes.insert(bytes.end(), buf, buf + n);
+    bool ok = (ferror(in) == 0);
+    fclose(in);
+    return ok;
+}
+
+static bool list_sprites(const char *dir, std::vector<Sprite>& sprites)
+{
+    DIR *d = opendir(dir);
+    if (!d)
+        return false;
+
+    struct dirent *entry;
+    while ((entry = readdir(d)) != nullptr)
+    {
+        std::string name = entry->d_name;
+        if (name.size() <= 4 || name.compare(name.size() - 4, 4, ".png") != 0)
+            continue;
+
+        Sprite s;
+        s.key = name.substr(0, name.size() - 4);
+        s.path = std::string(dir) + "/" + name;
+        sprites.push_back(s);
+    }
+    closedir(d);
+
+    // key order == `SpriteId` order (see `spritegen`)
+    std::sort(sprites.begin(), sprites.end(),
+        [](const Sprite& a, const Sprite& b) { return a.key < b.key; });
+    return true;
+}
+
+
+/**
+ * decode `s.path` and trim its fully transparent borders
+ */
+static bool load_sprite(Sprite& s)
+{
+    Image image = LoadImage(s.path.c_str());
+    if (!image.data)
+        return false;
+    ImageFormat(&image, UNCOMPRESSED_R8G8B8A8);
+
+    s.sw = image.width;
+    s.sh = image.height;
+    const uint32_t *px = (const uint32_t *)image.data;
+
+    // bounding box of the non-transparent pixels (alpha is the high byte)
+    int minX = s.sw, minY = s.sh, maxX = -1, maxY = -1;
+    for (int y = 0; y < s.sh; y++)
+        for (int x = 0; x < s.sw; x++)
+            if (px[y * s.sw + x] >> 24)
+            {
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+            }
+    if (maxX < 0)
+        s.trim = { 0, 0, 1, 1 }; // keep one (transparent) pixel
+    else
+        s.trim = { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+
+    s.pixels.resize((size_t)s.trim.w * s.trim.h);
+    for (int y = 0; y < s.trim.h; y++)
+        memcpy(&s.pixels[(size_t)y * s.trim.w], &px[(s.trim.y + y) * s.sw + s.trim.x], s.trim.w * 4);
+
+    UnloadImage(image);
+    return true;
+}
+
+
+/**
+ * MaxRects bin packer (J. Jylänki, "A Thousand Ways to Pack the Bin"):
+ * keeps every maximal free rectangle, places each rect where it leaves the
+ * shortest leftover side
+ */
+class MaxRects
+{
+public:
+    MaxRects(int width, int height) { this->free.push_back({ 0, 0, width, height }); }
+
+    bool insert(int w, int h, bool allowRotate, IntRect& placed, bool& rotated)
+    {
+        int bestShort = INT32_MAX, bestLong = INT32_MAX;
+        bool found = false;
+
+        for (const IntRect& f : this->free)
+        {
+            for (int turn = 0; turn < (allowRotate ? 2 : 1); turn++)
+            {
+                int rw = turn ? h : w;
+                int rh = turn ? w : h;
+                if (rw > f.w || rh > f.h)
+                    continue;
+
+                int leftW = f.w - rw, leftH = f.h - rh;
+                int shortSide = std::min(leftW, leftH);
+                int longSide = std::max(leftW, leftH);
+                if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+                {
+                    bestShort = shortSide;
+                    bestLong = longSide;
+                    placed = { f.x, f.y, rw, rh };
+                    rotated = (turn == 1);
+                    found = true;
+                }
+            }
+        }
+        if (!found)
+            return false;
+
+        this->split(placed);
+        this->prune();
+        return true;
+    }
+
+private:
+    std::vector<IntRect> free;
+
+    static bool intersects(const IntRect& a, const IntRect& b)
+    {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+    static bool contains(const IntRect& a, const IntRect& b)
+    {
+        return b.x >= a.x && b.y >= a.y && b.x + b.w <= a.x + a.w && b.y + b.h <= a.y + a.h;
+    }
+
+    // replace every free rect overlapping `used` by its (up to 4) maximal
+    // remainders
+    void split(const IntRect& used)
+    {
+        std::vector<IntRect> next;
+        for (const IntRect& f : this->free)
+        {
+            if (!intersects(f, used)) {
+                next.push_back(f);
+                continue;
+            }
+            if (used.x > f.x)
+                next.push_back({ f.x, f.y, used.x - f.x, f.h });
+            if (used.x + used.w < f.x + f.w)
+                next.push_back({ used.x + used.w, f.y, f.x + f.w - used.x - used.w, f.h });
+            if (used.y > f.y)
+                next.push_back({ f.x, f.y, f.w, used.y - f.y });
+            if (used.y + used.h < f.y + f.h)
+                next.push_back({ f.x, used.y + used.h, f.w, f.y + f.h - used.y - used.h });
+        }
+        this->free.swap(next);
+    }
+
+    // drop free rects contained in others
+    void prune()
+    {
+        for (size_t i = 0; i < this->free.size(); i++)
+            for (size_t j = i + 1; j < this->free.size(); j++)
+            {
+                if (contains(this->free[j], this->free[i])) {
+                    this->free.erase(this->free.begin() + i);
+                    i--;
+                    break;
+                }
+                if (contains(this->free[i], this->free[j])) {
+                    this->free.erase(this->free.begin() + j);
+                    j--;
+                }
+            }
+    }
+};
+
+
+/**
+ * smallest power-of-two page all sprites fit on (smallest area first, then
+ * the squarer one); false if none up to `ATLAS_MAX_SIZE` does
+ */
+static bool pack(std::vector<Sprite>& sprites, int& atlasW, int& atlasH)
+{
+    // biggest first packs tightest; key breaks ties so output is stable
+    std::vector<Sprite *> order;
+    long area = 0;
+    for (auto& s : sprites)
+    {
+        order.push_back(&s);
+        area += (long)(s.trim.w + ATLAS_PADDING) * (s.trim.h + ATLAS_PADDING);
+    }
+    std::sort(order.begin(), order.end(), [](const Sprite *a, const Sprite *b) {
+        int sa = std::max(a->trim.w, a->trim.h), sb = std::max(b->trim.w, b->trim.h);
+        if (sa != sb)
+            return sa > sb;
+        if (a->trim.w * a->trim.h != b->trim.w * b->trim.h)
+            return a->trim.w * a->trim.h > b->trim.w * b->trim.h;
+        return a->key < b->key;
+    });
+
+    std::vector<std::pair<int, int>> sizes;
+    for (int w = ATLAS_MIN_SIZE; w <= ATLAS_MAX_SIZE; w *= 2)
+        for (int h = ATLAS_MIN_SIZE; h <= ATLAS_MAX_SIZE; h *= 2)
+            if ((long)w * h >= area)
+                sizes.push_back(std::make_pair(w, h));
+    std::sort(sizes.begin(), sizes.end(), [](std::pair<int, int> a, std::pair<int, int> b) {
+        long areaA = (long)a.first * a.second, areaB = (long)b.first * b.second;
+        if (areaA != areaB)
+            return areaA < areaB;
+        int sideA = std::max(a.first, a.second), sideB = std::max(b.first, b.second);
+        if (sideA != sideB)
+            return sideA < sideB;
+        return a.first > b.first; // wide over tall
+    });
+
+    for (auto& size : sizes)
+    {
+        // padding goes right / below each sprite; the bin is grown by it so
+        // the last row / column needs none
+        MaxRects bin(size.first + ATLAS_PADDING, size.second + ATLAS_PADDING);
+        bool fits = true;
+        for (Sprite *s : order)
+        {
+            IntRect placed;
+            bool rotated = false;
+            bool square = (s->trim.w == s->trim.h);
+            if (!bin.insert(s->trim.w + ATLAS_PADDING, s->trim.h + ATLAS_PADDING, !square, placed, rotated)) {
+                fits = false;
+                break;
+            }
+            s->x = placed.x;
+            s->y = placed.y;
+            s->rotated = rotated;
+        }
+        if (fits) {
+            atlasW = size.first;
+            atlasH = size.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Cache
+ * -----
+ */
+
+struct CacheEntry
+{
+    uint64_t hash;
+    int sw, sh;
+    IntRect trim;
+    int x, y;
+    bool rotated;
+};
+
+struct Cache
+{
+    int atlasW = 0, atlasH = 0;
+    std::map<std::string, CacheEntry> sprites;
+};
+
+static bool load_cache(const char *path, Cache& cache)
+{
+    using nlohmann::json;
+
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    try {
+        json j;
+        in >> j;
+        if (j["version"] != ATLAS_CACHE_VERSION || j["padding"] != ATLAS_PADDING)
+            return false;
+
+        cache.atlasW = j["atlas"]["w"];
+        cache.atlasH = j["atlas"]["h"];
+        auto& jsprites = j["sprites"];
+        for (auto it = jsprites.begin(); it != jsprites.end(); ++it)
+        {
+            auto& js = it.value();
+            CacheEntry e;
+            e.hash = strtoull(js["hash"].get<std::string>().c_str(), nullptr, 16);
+            e.sw = js["source"][0];
+            e.sh = js["source"][1];
+            e.trim = { js["trim"][0], js["trim"][1], js["trim"][2], js["trim"][3] };
+            e.x = js["place"][0];
+            e.y = js["place"][1];
+            e.rotated = js["rotated"];
+            cache.sprites[it.key()] = e;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+static bool save_cache(const char *path, const std::vector<Sprite>& sprites, int atlasW, int atlasH)
+{
+    using nlohmann::json;
+
+    json j;
+    j["version"] = ATLAS_CACHE_VERSION;
+    j["padding"] = ATLAS_PADDING;
+    j["atlas"] = { { "w", atlasW }, { "h", atlasH } };
+    for (auto& s : sprites)
+    {
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)s.hash);
+        j["sprites"][s.key] = {
+            { "hash", hash },
+            { "source", { s.sw, s.sh } },
+            { "trim", { s.trim.x, s.trim.y, s.trim.w, s.trim.h } },
+            { "place", { s.x, s.y } },
+            { "rotated", s.rotated },
+        };
+    }
+
+    std::ofstream out(path);
+    out << j.dump(1) << "\n";
+    return (bool)out;
+}
+
+/**
+ * trimmed pixels of `s` (placed as in the cache) back from `pack`'s page
+ */
+static void copy_from_pack(const AssetPack& pack, Sprite& s)
+{
+    const PackPage& page = pack.page(0);
+    const uint32_t *src = (const uint32_t *)pack.pixels(0);
+
+    s.pixels.resize((size_t)s.trim.w * s.trim.h);
+    for (int ty = 0; ty < s.trim.h; ty++)
+        for (int tx = 0; tx < s.trim.w; tx++)
+        {
+            // turned clockwise, trimmed pixel (tx, ty) is stored at (h-1-ty, tx)
+            int ax = s.rotated ? s.x + s.trim.h - 1 - ty : s.x + tx;
+            int ay = s.rotated ? s.y + tx : s.y + ty;
+            s.pixels[(size_t)ty * s.trim.w + tx] = src[(size_t)ay * page.width + ax];
+        }
+}
+
+
+/**
+ * Output
+ * ------
+ */
+
+static std::string atlas_json(const std::vector<Sprite>& sprites, int atlasW, int atlasH, const char *packPath)
+{
+    using nlohmann::json;
+
+    const char *image = strrchr(packPath, '/');
+    image = image ? image + 1 : packPath;
+
+    json j;
+    for (auto& s : sprites)
+    {
+        bool trimmed = (s.trim.x != 0 || s.trim.y != 0 || s.trim.w != s.sw || s.trim.h != s.sh);
+        j["frames"][s.key] = {
+            { "frame", { { "x", s.x }, { "y", s.y }, { "w", s.trim.w }, { "h", s.trim.h } } },
+            { "rotated", s.rotated },
+            { "trimmed", trimmed },
+            { "spriteSourceSize", { { "x", s.trim.x }, { "y", s.trim.y }, { "w", s.trim.w }, { "h", s.trim.h } } },
+            { "sourceSize", { { "w", s.sw }, { "h", s.sh } } },
+        };
+    }
+    j["meta"] = {
+        { "app", "atlasgen" },
+        { "image", image },
+        { "format", "RGBA8888" },
+        { "size", { { "w", atlasW }, { "h", atlasH } } },
+    };
+    return j.dump(1) + "\n";
+}
+
+// leaves `path` (and its timestamp) alone if it already holds `text`
+static bool write_if_changed(const char *path, const std::string& text, bool& written)
+{
+    std::vector<uint8_t> old;
+    written = false;
+    if (read_file(path, old) && std::string(old.begin(), old.end()) == text)
+        return true;
+
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE *out = fopen(tmpPath.c_str(), "w");
+    if (!out)
+        return false;
+    bool ok = fwrite(text.data(), 1, text.size(), out) == text.size();
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), path) != 0) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    written = true;
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 5) {
+        fprintf(stderr, "usage: %s <sprites dir> <textures.json> <textures.pack> <cache>\n", argv[0]);
+        return 1;
+    }
+    const char *spritesDir = argv[1];
+    const char *jsonPath = argv[2];
+    const char *packPath = argv[3];
+    const char *cachePath = argv[4];
+
+    std::vector<Sprite> sprites;
+    if (!list_sprites(spritesDir, sprites) || sprites.empty()) {
+        fprintf(stderr, "atlasgen: no sprites in '%s'\n", spritesDir);
+        return 1;
+    }
+    for (auto& s : sprites)
+    {
+        std::vector<uint8_t> bytes;
+        if (!read_file(s.path, bytes)) {
+            fprintf(stderr, "atlasgen: can't read '%s'\n", s.path.c_str());
+            return 1;
+        }
+        s.hash = hash_bytes(bytes);
+    }
+
+    // the previous run's results are only usable together
+    Cache cache;
+    AssetPack prevPack;
+    bool haveCache = load_cache(cachePath, cache) &&
+        prevPack.open(packPath) && prevPack.pageCount() == 1 &&
+        (int)prevPack.page(0).width == cache.atlasW && (int)prevPack.page(0).height == cache.atlasH;
+
+    int numChanged = 0;
+    bool keepLayout = haveCache && cache.sprites.size() == sprites.size();
+    for (auto& s : sprites)
+    {
+        auto it = haveCache ? cache.sprites.find(s.key) : cache.sprites.end();
+        if (it != cache.sprites.end() && it->second.hash == s.hash)
+        {
+            const CacheEntry& e = it->second;
+            s.sw = e.sw;
+            s.sh = e.sh;
+            s.trim = e.trim;
+            s.x = e.x;
+            s.y = e.y;
+            s.rotated = e.rotated;
+            copy_from_pack(prevPack, s);
+            continue;
+        }
+
+        if (!load_sprite(s)) {
+            fprintf(stderr, "atlasgen: can't load '%s'\n", s.path.c_str());
+            return 1;
+        }
+        numChanged++;
+
+        // an edit that keeps the trimmed size can reuse the old place
+        if (it != cache.sprites.end() && it->second.trim.w == s.trim.w && it->second.trim.h == s.trim.h)
+        {
+            s.x = it->second.x;
+            s.y = it->second.y;
+            s.rotated = it->second.rotated;
+        }
+        else
+            keepLayout = false;
+    }
+    prevPack.close();
+
+    std::vector<uint8_t> prevJson;
+    if (keepLayout && numChanged == 0 && read_file(jsonPath, prevJson)) {
+        // still newer than its inputs for `make`
+        utime(packPath, nullptr);
+        printf("atlasgen: %d sprites up to date\n", (int)sprites.size());
+        return 0;
+    }
+
+    int atlasW = cache.atlasW, atlasH = cache.atlasH;
+    if (!keepLayout && !pack(sprites, atlasW, atlasH)) {
+        fprintf(stderr, "atlasgen: sprites don't fit on a %dx%d page\n", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return 1;
+    }
+
+    // blit (turned clockwise: trimmed pixel (tx, ty) goes to (h-1-ty, tx))
+    std::vector<uint32_t> page((size_t)atlasW * atlasH, 0);
+    std::vector<PackSprite> packSprites(sprites.size());
+    long usedArea = 0;
+    for (size_t i = 0; i < sprites.size(); i++)
+    {
+        Sprite& s = sprites[i];
+        for (int ty = 0; ty < s.trim.h; ty++)
+            for (int tx = 0; tx < s.trim.w; tx++)
+            {
+                int ax = s.rotated ? s.x + s.trim.h - 1 - ty : s.x + tx;
+                int ay = s.rotated ? s.y + tx : s.y + ty;
+                page[(size_t)ay * atlasW + ax] = s.pixels[(size_t)ty * s.trim.w + tx];
+            }
+        usedArea += (long)s.trim.w * s.trim.h;
+
+        int w = s.rotated ? s.trim.h : s.trim.w;
+        int h = s.rotated ? s.trim.w : s.trim.h;
+        if (!make_pack_sprite(packSprites[i], s.key, 0, atlasW, atlasH,
+                s.x, s.y, w, h, s.rotated, s.trim.x, s.trim.y, s.sw, s.sh)) {
+            fprintf(stderr, "atlasgen: key '%s' is too long\n", s.key.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<PackPageData> pages(1);
+    pages[0].width = atlasW;
+    pages[0].height = atlasH;
+    pages[0].pixels = page.data();
+    uint64_t packSize = write_pack(packPath, "atlasgen", packSprites, pages);
+    if (packSize == 0)
+        return 1;
+
+    bool jsonWritten;
+    if (!write_if_changed(jsonPath, atlas_json(sprites, atlasW, atlasH, packPath), jsonWritten)) {
+        fprintf(stderr, "atlasgen: can't write '%s'\n", jsonPath);
+        return 1;
+    }
+    if (!save_cache(cachePath, sprites, atlasW, atlasH))
+        fprintf(stderr, "atlasgen: can't write '%s' (next run repacks)\n", cachePath);
+
+    printf("atlasgen: %d sprites (%d decoded), %s %dx%d page, %.0f%% used -> '%s' (%llu bytes)%s\n",
+        (int)sprites.size(), numChanged, keepLayout ? "kept" : "packed", atlasW, atlasH,
+        100.0 * usedArea / ((double)atlasW * atlasH), packPath, (unsigned long long)packSize,
+        jsonWritten ? "" : ", frames unchanged");
+    return 0;
+}
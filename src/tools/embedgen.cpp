@@ -0,0 +1,102 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/embedgen.cpp
+ * - build step for `EMBED_ASSETS`: turns an asset pack (see `packer`) into a
+ *   source file defining `EMBEDDED_PACK` / `EMBEDDED_PACK_SIZE`, so the pack
+ *   is linked into the executable instead of read from disk
+ *
+ * usage:
+ *   embedgen <textures.pack> <EmbeddedPack.cpp>
+ * -----------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <textures.pack> <EmbeddedPack.cpp>\n", argv[0]);
+        return 1;
+    }
+    const char *inPath = argv[1];
+    const char *outPath = argv[2];
+
+    FILE *in = fopen(inPath, "rb");
+    if (!in) {
+        fprintf(stderr, "embedgen: can't open '%s'\n", inPath);
+        return 1;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buf[1 << 16];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+        bytes.insert(bytes.end(), buf, buf + n);
+    bool readOk = (ferror(in) == 0);
+    fclose(in);
+    if (!readOk || bytes.empty()) {
+        fprintf(stderr, "embedgen: can't read '%s'\n", inPath);
+        return 1;
+    }
+
+    size_t size = bytes.size();
+    // pad to whole words (host byte order, like the pack itself)
+    bytes.resize((size + 3) / 4 * 4, 0);
+    size_t numWords = bytes.size() / 4;
+
+    // write to a temp file first so a failed run never leaves a half source
+    std::string tmpPath = std::string(outPath) + ".tmp";
+    FILE *out = fopen(tmpPath.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "embedgen: can't write '%s'\n", tmpPath.c_str());
+        return 1;
+    }
+
+    fprintf(out,
+        "/**\n"
+        " * -----------------------------------------------------------------------------\n"
+        " * EmbeddedPack.cpp\n"
+        " * GENERATED by `embedgen` from '%s' -- do not edit\n"
+        " * -----------------------------------------------------------------------------\n"
+        " */\n"
+        "#include \"core/AssetPack.hpp\"\n"
+        "\n"
+        "#if !EMBED_ASSETS\n"
+        "    #error \"EmbeddedPack.cpp needs EMBED_ASSETS\"\n"
+        "#endif\n"
+        "\n"
+        "\n"
+        "const size_t EMBEDDED_PACK_SIZE = %zu;\n"
+        "\n"
+        "// page aligned like a mapping\n"
+        "alignas(PACK_PAGE_ALIGN) const uint32_t EMBEDDED_PACK[%zu] = {\n",
+        inPath, size, numWords
+    );
+    for (size_t i = 0; i < numWords; i++)
+    {
+        uint32_t word;
+        memcpy(&word, &bytes[i * 4], 4);
+        // most of an atlas is transparent: keep zeros short
+        if (word == 0)
+            fputs("0,", out);
+        else
+            fprintf(out, "0x%x,", word);
+        if (i % 16 == 15)
+            fputc('\n', out);
+    }
+    fprintf(out, "\n};\n");
+
+    bool ok = (ferror(out) == 0);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), outPath) != 0) {
+        fprintf(stderr, "embedgen: can't write '%s'\n", outPath);
+        remove(tmpPath.c_str());
+        return 1;
+    }
+
+    printf("embedgen: %zu bytes -> '%s'\n", size, outPath);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/packer.cpp
+ * - build step: bakes the TexturePacker atlas (`textures.json` + its png)
+ *   into one `AssetPack` (see `core/AssetPack.hpp`) with the sprite table in
+ *   `SpriteId` order and the pixels already decoded to RGBA8, so the game
+ *   only has to map the file and upload it
+ * - used with `ATLAS_SOURCE=texturepacker`; `atlasgen` packs the sprites
+ *   itself and writes the pack directly
+ *
+ * usage:
+ *   packer <textures.json> <textures.png> <textures.pack>
+ * -----------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+#include "AtlasJson.hpp"
+#include "PackWriter.hpp"
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s <textures.json> <textures.png> <textures.pack>\n", argv[0]);
+        return 1;
+    }
+    const char *jsonPath = argv[1];
+    const char *pngPath = argv[2];
+    const char *outPath = argv[3];
+
+    std::vector<AtlasFrame> frames;
+    int atlasW, atlasH;
+    if (!load_atlas_json(jsonPath, "packer", frames, atlasW, atlasH))
+        return 1;
+
+    // decode once here instead of on every start
+    Image image = LoadImage(pngPath);
+    if (!image.data) {
+        fprintf(stderr, "packer: can't load '%s'\n", pngPath);
+        return 1;
+    }
+    ImageFormat(&image, UNCOMPRESSED_R8G8B8A8);
+
+    if (atlasW != image.width || atlasH != image.height) {
+        fprintf(stderr, "packer: '%s' is %dx%d, '%s' says %dx%d\n",
+            pngPath, image.width, image.height, jsonPath, atlasW, atlasH);
+        UnloadImage(image);
+        return 1;
+    }
+
+    // NOTE: same (key) order as `spritegen`, so table index == `SpriteId`
+    std::vector<PackSprite> sprites(frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        auto& f = frames[i];
+        if (!make_pack_sprite(sprites[i], f.key, 0, atlasW, atlasH,
+                f.x, f.y, f.w, f.h, f.rotated, f.ox, f.oy, f.sw, f.sh)) {
+            fprintf(stderr, "packer: key '%s' is too long\n", f.key.c_str());
+            UnloadImage(image);
+            return 1;
+        }
+    }
+
+    std::vector<PackPageData> pages(1);
+    pages[0].width = image.width;
+    pages[0].height = image.height;
+    pages[0].pixels = image.data;
+
+    uint64_t size = write_pack(outPath, "packer", sprites, pages);
+    UnloadImage(image);
+    if (size == 0)
+        return 1;
+
+    printf("packer: %d sprites, %dx%d page -> '%s' (%llu bytes)\n",
+        (int)sprites.size(), atlasW, atlasH, outPath, (unsigned long long)size);
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * -----------------------------------------------------------------------------
+ * tools/spritegen.cpp
+ * - build step: turns the atlas description (`textures.json`, see
+ *   `AtlasJson.hpp`) into a header with a `SpriteId`
+ *   enum and constexpr frame / UV tables, so the renderer indexes sprites
+ *   directly instead of hashing string keys every frame
+ *
+ * usage:
+ *   spritegen <textures.json> <Sprites.hpp>
+ * -----------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "AtlasJson.hpp"
+
+
+struct Frame : AtlasFrame
+{
+    std::string name;
+};
+
+
+/**
+ * "yellowbird-downflap" -> "YellowbirdDownflap", "num-0" -> "Num0"
+ */
+static std::string to_enum_name(const std::string& key)
+{
+    std::string name;
+    bool upper = true;
+    for (char c : key)
+    {
+        bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (!alnum) {
+            upper = true;
+            continue;
+        }
+        name += (upper && c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+        upper = false;
+    }
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+        name = "Sprite" + name;
+    return name;
+}
+
+
+/**
+ * float literal that round-trips (always has a '.' or exponent, then 'f')
+ */
+static std::string float_literal(double v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.9g", v);
+    std::string s(buf);
+    if (s.find_first_of(".e") == std::string::npos)
+        s += ".0";
+    return s + "f";
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <textures.json> <Sprites.hpp>\n", argv[0]);
+        return 1;
+    }
+    const char *inPath = argv[1];
+    const char *outPath = argv[2];
+
+    std::vector<AtlasFrame> atlasFrames;
+    int atlasW, atlasH;
+    if (!load_atlas_json(inPath, "spritegen", atlasFrames, atlasW, atlasH))
+        return 1;
+
+    // NOTE: frames come in key order, so numbered frames ("num-0" ..
+    // "num-9") end up contiguous in the enum
+    std::vector<Frame> frames;
+    for (auto& f : atlasFrames)
+    {
+        Frame frame;
+        static_cast<AtlasFrame&>(frame) = f;
+        frame.name = to_enum_name(frame.key);
+
+        for (auto& other : frames)
+            if (other.name == frame.name) {
+                fprintf(stderr, "spritegen: '%s' and '%s' both map to '%s'\n",
+                    other.key.c_str(), frame.key.c_str(), frame.name.c_str());
+                return 1;
+            }
+        frames.push_back(frame);
+    }
+
+    // write to a temp file first so a failed run never leaves a half header
+    std::string tmpPath = std::string(outPath) + ".tmp";
+    FILE *out = fopen(tmpPath.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "spritegen: can't write '%s'\n", tmpPath.c_str());
+        return 1;
+    }
+
+    fprintf(out,
+        "/**\n"
+        " * -----------------------------------------------------------------------------\n"
+        " * Sprites.hpp\n"
+        " * GENERATED by `spritegen` from '%s' -- do not edit\n"
+        " * -----------------------------------------------------------------------------\n"
+        " */\n"
+        "#pragma once\n"
+        "\n"
+        "\n"
+        "enum class SpriteId {\n",
+        inPath
+    );
+    for (auto& f : frames)
+        fprintf(out, "    %s,\n", f.name.c_str());
+    fprintf(out,
+        "};\n"
+        "\n"
+        "static constexpr int SPRITE_COUNT = %d;\n"
+        "\n"
+        "// atlas size (px)\n"
+        "static constexpr int SPRITE_ATLAS_WIDTH = %d;\n"
+        "static constexpr int SPRITE_ATLAS_HEIGHT = %d;\n"
+        "\n"
+        "\n"
+        "struct SpriteFrame\n"
+        "{\n"
+        "    // rect covered in the atlas (px; swapped if `rotated`)\n"
+        "    float x, y, w, h;\n"
+        "    // the same rect normalized to [0, 1] texture coordinates\n"
+        "    float u, v, uw, vh;\n"
+        "    // trimmed pixels start at (`ox`, `oy`) in the untrimmed `sw` x `sh` sprite\n"
+        "    float ox, oy, sw, sh;\n"
+        "    // stored turned 90 degrees clockwise\n"
+        "    bool rotated;\n"
+        "};\n"
+        "\n"
+        "// indexed by `SpriteId`\n"
+        "static constexpr SpriteFrame SPRITE_FRAMES[SPRITE_COUNT] = {\n",
+        (int)frames.size(), atlasW, atlasH
+    );
+    for (auto& f : frames)
+        fprintf(out, "    { %d, %d, %d, %d, %s, %s, %s, %s, %d, %d, %d, %d, %s }, // %s\n",
+            f.x, f.y, f.w, f.h,
+            float_literal((double)f.x / atlasW).c_str(),
+            float_literal((double)f.y / atlasH).c_str(),
+            float_literal((double)f.w / atlasW).c_str(),
+            float_literal((double)f.h / atlasH).c_str(),
+            f.ox, f.oy, f.sw, f.sh,
+            f.rotated ? "true" : "false",
+            f.name.c_str()
+        );
+    fprintf(out,
+        "};\n"
+        "\n"
+        "// original atlas keys (debugging / logging only)\n"
+        "static constexpr const char *SPRITE_KEYS[SPRITE_COUNT] = {\n"
+    );
+    for (auto& f : frames)
+        fprintf(out, "    \"%s\",\n", f.key.c_str());
+    fprintf(out, "};\n");
+
+    bool ok = (ferror(out) == 0);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), outPath) != 0) {
+        fprintf(stderr, "spritegen: can't write '%s'\n", outPath);
+        remove(tmpPath.c_str());
+        return 1;
+    }
+
+    printf("spritegen: %d sprites -> '%s'\n", (int)frames.size(), outPath);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * -----------------------------------------------------------------------------
+ * AlignedArray
+ * - fixed-size heap array that honours `alignof(T)` (C++11 `std::vector` /
+ *   `new[]` don't for over-aligned types such as `alignas(64)` structs)
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <assert.h>
+#include <stdlib.h>
+#include <new>
+
+
+template<class T>
+class AlignedArray
+{
+protected:
+    T*     mData;
+    size_t mSize;
+
+public:
+    AlignedArray() : mData(nullptr), mSize(0)       { }
+    explicit AlignedArray(size_t size) : AlignedArray() { resize(size); }
+    ~AlignedArray()                                 { clear(); }
+
+    AlignedArray(const AlignedArray&) = delete;
+    AlignedArray& operator=(const AlignedArray&) = delete;
+
+    // discards the current contents; new elements are default constructed
+    void resize(size_t size)
+    {
+        clear();
+        if (size == 0) return;
+
+        void *mem = nullptr;
+        size_t align = alignof(T) < sizeof(void *) ? sizeof(void *) : alignof(T);
+        if (posix_memalign(&mem, align, size * sizeof(T)) != 0)
+            abort();
+
+        mData = (T *)mem;
+        mSize = size;
+        for (size_t i = 0; i < size; i++)
+            new (&mData[i]) T();
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < mSize; i++)
+            mData[i].~T();
+        free(mData);
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    size_t size() const                     { return mSize; }
+    T* data()                               { return mData; }
+    const T* data() const                   { return mData; }
+
+    T& operator [](const size_t i)              { assert(i < mSize); return mData[i]; }
+    const T& operator [](const size_t i) const  { assert(i < mSize); return mData[i]; }
+
+    T* begin()                              { return mData; }
+    T* end()                                { return mData + mSize; }
+    const T* begin() const                  { return mData; }
+    const T* end() const                    { return mData + mSize; }
+};
@@ -0,0 +1,149 @@
+#include "util/Collision.hpp"
+
+
+constexpr float Collision::NO_HIT;
+
+
+// widen a lane mask to one byte per lane; returns the number of set lanes
+static inline int store_hits(simd::vi mask, uint8_t *hits)
+{
+    int numHits = 0;
+    for (int l = 0; l < simd::LANES; l++)
+    {
+        hits[l] = (uint8_t)(mask[l] & 1);
+        numHits += hits[l];
+    }
+    return numHits;
+}
+
+
+int Collision::circleVsRects(
+    float cx, float cy, float cr,
+    const float *rx, const float *ry, const float *rw, const float *rh,
+    int count, uint8_t *hits
+) {
+    using namespace simd;
+
+    const vf vcx = splat(cx);
+    const vf vcy = splat(cy);
+    const vf vcr = splat(cr);
+
+    int numHits = 0;
+    int i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        vi hit = circleRect(vcx, vcy, vcr, load(&rx[i]), load(&ry[i]), load(&rw[i]), load(&rh[i]));
+        numHits += store_hits(hit, &hits[i]);
+    }
+
+    return numHits + circleVsRectsScalar(
+        cx, cy, cr, &rx[i], &ry[i], &rw[i], &rh[i], count - i, &hits[i]
+    );
+}
+
+int Collision::circlesVsRect(
+    const float *cx, const float *cy, float cr,
+    float rx, float ry, float rw, float rh,
+    int count, uint8_t *hits
+) {
+    using namespace simd;
+
+    const vf vcr = splat(cr);
+    const vf vrx = splat(rx);
+    const vf vry = splat(ry);
+    const vf vrw = splat(rw);
+    const vf vrh = splat(rh);
+
+    int numHits = 0;
+    int i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        vi hit = circleRect(load(&cx[i]), load(&cy[i]), vcr, vrx, vry, vrw, vrh);
+        numHits += store_hits(hit, &hits[i]);
+    }
+
+    return numHits + circlesVsRectScalar(
+        &cx[i], &cy[i], cr, rx, ry, rw, rh, count - i, &hits[i]
+    );
+}
+
+int Collision::circleVsRectsScalar(
+    float cx, float cy, float cr,
+    const float *rx, const float *ry, const float *rw, const float *rh,
+    int count, uint8_t *hits
+) {
+    int numHits = 0;
+    for (int i = 0; i < count; i++)
+    {
+        hits[i] = circleRect(cx, cy, cr, rx[i], ry[i], rw[i], rh[i]);
+        numHits += hits[i];
+    }
+    return numHits;
+}
+
+int Collision::circlesVsRectScalar(
+    const float *cx, const float *cy, float cr,
+    float rx, float ry, float rw, float rh,
+    int count, uint8_t *hits
+) {
+    int numHits = 0;
+    for (int i = 0; i < count; i++)
+    {
+        hits[i] = circleRect(cx[i], cy[i], cr, rx, ry, rw, rh);
+        numHits += hits[i];
+    }
+    return numHits;
+}
+
+// narrow `[tMin, tMax]` to where `p + t*d` lies in `[lo, hi]` (one slab)
+static inline bool clip_slab(float p, float d, float lo, float hi, float& tMin, float& tMax)
+{
+    if (d == 0)
+        return p >= lo && p <= hi;
+
+    float t0 = (lo - p) / d;
+    float t1 = (hi - p) / d;
+    if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+
+    tMin = Math::max(tMin, t0);
+    tMax = Math::min(tMax, t1);
+    return tMin <= tMax;
+}
+
+float Collision::sweptCircleRect(
+    float cx, float cy, float dx, float dy, float cr,
+    float rx, float ry, float rw, float rh
+) {
+    if (circleRect(cx, cy, cr, rx, ry, rw, rh))
+        return 0;
+
+    // entry into the rect grown by the radius
+    float tMin = 0, tMax = 1;
+    if (!clip_slab(cx, dx, rx - cr, rx + rw + cr, tMin, tMax) ||
+        !clip_slab(cy, dy, ry - cr, ry + rh + cr, tMin, tMax))
+        return NO_HIT;
+
+    float px = cx + dx * tMin;
+    float py = cy + dy * tMin;
+    bool inX = px >= rx && px <= rx + rw;
+    bool inY = py >= ry && py <= ry + rh;
+    if (inX || inY)
+        return tMin; // entered through a face
+
+    // corner region: the rounded corner is a circle of radius `cr` around
+    // the rect corner; a ray missing it leaves the grown rect untouched
+    float kx = px < rx ? rx : rx + rw;
+    float ky = py < ry ? ry : ry + rh;
+    float ox = cx - kx;
+    float oy = cy - ky;
+
+    float a = dx * dx + dy * dy;
+    float b = ox * dx + oy * dy;
+    float c = ox * ox + oy * oy - cr * cr;
+    float disc = b * b - a * c;
+    if (a == 0 || disc < 0)
+        return NO_HIT;
+
+    float t = (-b - sqrtf(disc)) / a;
+    return (t >= 0 && t <= 1) ? t : NO_HIT;
+}
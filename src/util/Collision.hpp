@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * -----------------------------------------------------------------------------
+ * Collision
+ * - circle vs axis-aligned rect overlap tests; rects are (x, y, w, h) with
+ *   (x, y) the top-left corner
+ * - the batched versions take packed (SoA) arrays and write one hit byte per
+ *   test (1 / 0); full `simd::LANES` chunks go through the vector kernel, the
+ *   tail through the scalar one. Both round identically, so results never
+ *   depend on the path taken.
+ * - `sweptCircleRect()` is the continuous version: first time of impact of a
+ *   moving circle, so fast movers can't tunnel through thin rects
+ * -----------------------------------------------------------------------------
+ */
+
+#include <stdint.h>
+
+#include "util/package.hpp"
+#include "util/Simd.hpp"
+
+
+class Collision
+{
+public:
+    /**
+     * see for explanation:
+     * https://yal.cc/rectangle-circle-intersection-test/
+     */
+    static bool circleRect(float cx, float cy, float cr, float rx, float ry, float rw, float rh)
+    {
+        float deltaX = cx - Math::max(rx, Math::min(cx, rx + rw));
+        float deltaY = cy - Math::max(ry, Math::min(cy, ry + rh));
+        return (deltaX * deltaX + deltaY * deltaY) < (cr * cr);
+    }
+
+    // same test, one circle / rect pair per lane; returns a lane mask
+    static inline simd::vi circleRect(
+        simd::vf cx, simd::vf cy, simd::vf cr,
+        simd::vf rx, simd::vf ry, simd::vf rw, simd::vf rh
+    ) {
+        using namespace simd;
+
+        vf deltaX = cx - max(rx, min(cx, rx + rw));
+        vf deltaY = cy - max(ry, min(cy, ry + rh));
+        return (deltaX * deltaX + deltaY * deltaY) < (cr * cr);
+    }
+
+    // returned by `sweptCircleRect()` when there's no impact
+    static constexpr float NO_HIT = 2.f;
+
+    /**
+     * circle at (cx, cy) moving by (dx, dy) over t in [0, 1]: returns the
+     * first t where it overlaps the rect (0 if it already does), or `NO_HIT`.
+     * Ray vs the rect grown by `cr` (slabs), then vs the corner circle when
+     * the entry point lies in a corner region.
+     */
+    static float sweptCircleRect(
+        float cx, float cy, float dx, float dy, float cr,
+        float rx, float ry, float rw, float rh
+    );
+
+    // one circle vs `count` rects; returns the number of hits
+    static int circleVsRects(
+        float cx, float cy, float cr,
+        const float *rx, const float *ry, const float *rw, const float *rh,
+        int count, uint8_t *hits
+    );
+
+    // `count` circles (same radius) vs one rect; returns the number of hits
+    static int circlesVsRect(
+        const float *cx, const float *cy, float cr,
+        float rx, float ry, float rw, float rh,
+        int count, uint8_t *hits
+    );
+
+    // scalar reference versions of the above (tests / benchmarks)
+    static int circleVsRectsScalar(
+        float cx, float cy, float cr,
+        const float *rx, const float *ry, const float *rw, const float *rh,
+        int count, uint8_t *hits
+    );
+    static int circlesVsRectScalar(
+        const float *cx, const float *cy, float cr,
+        float rx, float ry, float rw, float rh,
+        int count, uint8_t *hits
+    );
+};
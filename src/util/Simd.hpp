@@ -0,0 +1,84 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Simd
+ * - thin wrapper around GCC / Clang vector extensions; compiles to SSE / AVX /
+ *   NEON / wasm-simd depending on target flags, and to scalar code otherwise.
+ * - all comparisons return lane masks (-1 / 0) so branches can be replaced
+ *   with `simd::select()`.
+ * -----------------------------------------------------------------------------
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+
+namespace simd
+{
+    // number of f32 lanes processed per op; matches the native register
+    // width, since wider vectors get split (badly) when the ISA lacks them
+#if defined(__AVX512F__)
+    static const int LANES = 16;
+#elif defined(__AVX__)
+    static const int LANES = 8;
+#else
+    static const int LANES = 4;
+#endif
+
+    typedef float   vf __attribute__((vector_size(LANES * sizeof(float))));
+    typedef int32_t vi __attribute__((vector_size(LANES * sizeof(int32_t))));
+
+    inline vf splat(float x)
+    {
+        vf v;
+        for (int i = 0; i < LANES; i++) v[i] = x;
+        return v;
+    }
+
+    inline vi splat(int32_t x)
+    {
+        vi v;
+        for (int i = 0; i < LANES; i++) v[i] = x;
+        return v;
+    }
+
+    // unaligned-safe loads / stores (compile to single vector moves)
+    inline vf load(const float *p)     { vf v; memcpy(&v, p, sizeof(v)); return v; }
+    inline vi load(const int32_t *p)   { vi v; memcpy(&v, p, sizeof(v)); return v; }
+    inline void store(float *p, vf v)  { memcpy(p, &v, sizeof(v)); }
+    inline void store(int32_t *p, vi v) { memcpy(p, &v, sizeof(v)); }
+
+    // int -> float per lane (same rounding as a scalar `(float)` cast)
+    inline vf tofloat(vi x)    { return __builtin_convertvector(x, vf); }
+
+    // per-lane `mask ? a : b`
+    inline vf select(vi mask, vf a, vf b)
+    {
+        return (vf)(((vi)a & mask) | ((vi)b & ~mask));
+    }
+    inline vi select(vi mask, vi a, vi b)
+    {
+        return (a & mask) | (b & ~mask);
+    }
+
+    // same semantics as `Math::min()` / `Math::max()` (incl. NaN handling)
+    inline vf min(vf x, vf y) { return select(x < y, x, y); }
+    inline vf max(vf x, vf y) { return select(x > y, x, y); }
+    inline vf clamp(vf x, vf minVal, vf maxVal) { return max(min(x, maxVal), minVal); }
+
+    // true if any lane of `mask` is set
+    inline bool any(vi mask)
+    {
+        int32_t r = 0;
+        for (int i = 0; i < LANES; i++) r |= mask[i];
+        return r != 0;
+    }
+
+    // one bit per lane (lane 0 -> bit 0)
+    inline uint32_t bits(vi mask)
+    {
+        uint32_t r = 0;
+        for (int i = 0; i < LANES; i++) r |= (uint32_t)(mask[i] & 1) << i;
+        return r;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+
+/**
+ * rejects axis-aligned bounds that lie completely outside a view rect and
+ * counts what it tested / rejected; usable for any entity list (sprites,
+ * pipes, particles, ...) in whatever space `view` is given in
+ */
+class ViewCuller
+{
+public:
+    Rectf view;
+    bool enabled = false;
+    int tested = 0;
+    int culled = 0;
+
+    void begin(const Rectf& view)
+    {
+        this->view = view;
+        this->enabled = true;
+        this->tested = 0;
+        this->culled = 0;
+    }
+
+    void disable()
+    { this->enabled = false; }
+
+    bool visible(float minX, float minY, float maxX, float maxY)
+    {
+        if (!this->enabled)
+            return true;
+
+        this->tested++;
+        bool outside = (
+            maxX < this->view.left() || minX > this->view.right() ||
+            maxY < this->view.top() || minY > this->view.bottom()
+        );
+        this->culled += outside;
+        return !outside;
+    }
+
+    bool visible(const Rectf& bounds)
+    {
+        // NOTE: sizes may be negative (flipped)
+        float x0 = bounds.left(), x1 = bounds.right();
+        float y0 = bounds.top(), y1 = bounds.bottom();
+        return this->visible(
+            x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+            x0 < x1 ? x1 : x0, y0 < y1 ? y1 : y0
+        );
+    }
+};
@@ -27,9 +27,13 @@
 //Patterns
 #include "events.hpp"
 #include "Optional.hpp"
+#include "AlignedArray.hpp"
 
 //Math
 #include "Math.hpp"
 #include "Vector.hpp"
 #include "Matrix.hpp"
 #include "Rect.hpp"
+
+//Culling
+#include "ViewCuller.hpp"